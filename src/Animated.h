@@ -16,7 +16,22 @@ public:
     int animationIndex;
 
     /**
-     * @brief Lista de animaciones asociadas a este objeto.
+     * @brief Animaciones asociadas a este objeto, compartidas a travs de `AnimationLibrary`.
      */
-    std::vector<Animation> animations;
+    std::vector<const Animation*> animations;
+
+    /**
+     * @brief ndice del estado de reproduccin en `AnimationSystem`.
+     */
+    int animationState;
+
+    /**
+     * @brief Generacin de `AnimationSystem` en la que se registr `animationState`.
+     */
+    unsigned int animationGeneration;
+
+    /**
+     * @brief Cuadro que se dibuja, copiado del `AnimationSystem` al capturar la instantnea.
+     */
+    int currentFrame;
 };
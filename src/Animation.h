@@ -1,13 +1,15 @@
 #pragma once
+#include <vector>
 #include <raylib.h>
 
 /**
  * @class Animation
  * @brief Clase que representa una animación basada en cuadros (frames).
  *
- * Esta clase encapsula información y metodos relacionados con la
- * reproducción de animaciones, como el número de cuadros, velocidad,
- * y el area de textura para cada cuadro.
+ * Esta clase encapsula la información de una animación, como el número de
+ * cuadros, la velocidad y el area de textura para cada cuadro. Es inmutable y se
+ * comparte entre todos los sprites (ver `AnimationLibrary`); el cuadro que se
+ * está reproduciendo lo lleva `AnimationSystem`.
  */
 
 class Animation {
@@ -18,24 +20,9 @@ public:
     int numFrames;
 
     /**
-     * @brief Temporizador interno para controlar el cambio de cuadros.
+     * @brief Velocidad de la animación en cuadros por segundo.
      */
-    double frameTimer;
-
-    /**
-     * @brief Velocidad de la animación en segundos por cuadro.
-     */
-    double animationSpeed;
-
-    /**
-     * @brief área de la textura que contiene los cuadros de la animación.
-     */
-    Rectangle textureArea;
-
-    /**
-     * @brief Posici�n donde se renderiza la animación en la ventana.
-     */
-    Rectangle positionOnWindow;
+    double framesPerSecond;
 
     /**
      * @brief Textura que contiene los cuadros de la animación.
@@ -43,41 +30,8 @@ public:
     Texture texture;
 
     /**
-     * @brief Indica si la animación debe detenerse.
-     */
-    bool stop;
-
-    /**
-     * @brief Devuelve el cuadro actual de la animación.
-     * @return Un entero que representa el índice del cuadro actual.
-     */
-    int getCurrentFrame();
-
-    /**
-     * @brief Verifica si la animación ha llegado al último cuadro.
-     * @return true si la animación ha terminado, false en caso contrario.
-     */
-
-    bool isAnimationDone();
-
-    /**
-     * @brief Reinicia la animación al primer cuadro.
-     */
-
-    void resetAnimation();
-
-    /**
-     * @brief Avanza al siguiente cuadro en la animación.
-     *
-     * Si la animación llega al último cuadro, vuelve al primero.
-     */
-
-    void nextFrame();
-
-private:
-    /**
-     * @brief Cuadro actual que se estr reproduciendo.
+     * @brief Área de la textura de cada cuadro, precalculada al crear la animación.
      */
-    int currentFrame;
+    std::vector<Rectangle> frames;
 };
 
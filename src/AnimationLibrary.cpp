@@ -0,0 +1,48 @@
+#include "AnimationLibrary.h"
+#include "TextureManager.h"
+
+const Animation* AnimationLibrary::getAnimation(const std::string& name)
+{
+	auto animation = animations.find(name);
+	if (animation == animations.end()) {
+		return nullptr;
+	}
+	return &animation->second;
+}
+
+AnimationLibrary* AnimationLibrary::instance;
+
+AnimationLibrary* AnimationLibrary::getInstance()
+{
+	if (!instance) {
+		instance = new AnimationLibrary();
+	}
+	return instance;
+}
+
+void AnimationLibrary::addAnimation(const std::string& name, const std::string& texturePath, int numFrames, double framesPerSecond)
+{
+	Animation animation = {};
+	animation.texture = TextureManager::getInstance()->getTexture(texturePath);
+	animation.numFrames = numFrames;
+	animation.framesPerSecond = framesPerSecond;
+	float frameWidth = (float)(animation.texture.width / numFrames);
+	for (int i = 0; i < numFrames; i++) {
+		animation.frames.push_back({ i * frameWidth, 0, frameWidth, (float)animation.texture.height });
+	}
+	animations[name] = animation;
+}
+
+AnimationLibrary::AnimationLibrary()
+{
+	addAnimation("demon_walk", "sprites/animated/demon_walk.png", 4, 7.5);
+	addAnimation("demon_hurt", "sprites/animated/demon_hurt.png", 5, 10);
+	addAnimation("demon_death", "sprites/animated/demon_death.png", 7, 13);
+	addAnimation("zombie_walk", "sprites/animated/zombie_walk.png", 4, 6);
+	addAnimation("zombie_hurt", "sprites/animated/zombie_hurt.png", 4, 7);
+	addAnimation("zombie_death", "sprites/animated/zombie_death.png", 7, 6);
+	addAnimation("lamp_red", "sprites/animated/lamp.png", 4, 20);
+	addAnimation("lamp_green", "sprites/animated/lamp_green.png", 4, 20);
+	addAnimation("fireball", "sprites/animated/fireball.png", 2, 20);
+	addAnimation("shotgun", "sprites/animated/gun.png", 11, 10);
+}
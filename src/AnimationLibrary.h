@@ -0,0 +1,54 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include "Animation.h"
+
+/**
+ * @class AnimationLibrary
+ * @brief Guarda una sola copia de cada animación del juego.
+ *
+ * Las animaciones son definiciones inmutables (textura, cuadros, velocidad y área de
+ * cada cuadro) que se crean una vez y se comparten entre todos los enemigos, lámparas,
+ * proyectiles y el arma. Cada sprite guarda solo punteros a ellas y su estado de
+ * reproducción vive en `AnimationSystem`.
+ */
+class AnimationLibrary {
+public:
+    /**
+     * @brief Obtiene una animación por nombre.
+     *
+     * @param name Nombre de la animación, por ejemplo "demon_walk".
+     * @return Puntero a la animación compartida, o `nullptr` si no existe.
+     */
+    const Animation* getAnimation(const std::string& name);
+
+    /**
+     * @brief Obtiene la instancia única de `AnimationLibrary`.
+     *
+     * La primera llamada crea todas las animaciones, por lo que las texturas ya
+     * deben estar cargadas en VRAM.
+     * @return Puntero a la instancia única.
+     */
+    static AnimationLibrary* getInstance();
+
+private:
+    std::unordered_map<std::string, Animation> animations; ///< Animaciones por nombre.
+    static AnimationLibrary* instance;                      ///< Instancia única de la clase (Singleton).
+
+    /**
+     * @brief Crea una animación y precalcula el área de textura de cada cuadro.
+     *
+     * Los cuadros están uno al lado del otro en una tira horizontal.
+     *
+     * @param name Nombre de la animación.
+     * @param texturePath Ruta de la textura dentro de la carpeta de texturas.
+     * @param numFrames Cantidad de cuadros de la tira.
+     * @param framesPerSecond Velocidad de la animación.
+     */
+    void addAnimation(const std::string& name, const std::string& texturePath, int numFrames, double framesPerSecond);
+
+    /**
+     * @brief Constructor privado; crea todas las animaciones del juego.
+     */
+    AnimationLibrary();
+};
@@ -0,0 +1,169 @@
+#include "AnimationSystem.h"
+
+void AnimationSystem::update(double deltaTime)
+{
+	for (auto& state : states) {
+		if (!state.used || state.paused || state.stopped || state.framesPerSecond <= 0) {
+			continue;
+		}
+		state.time += deltaTime;
+		double frameTime = 1.0 / state.framesPerSecond;
+		while (state.time >= frameTime) {
+			state.time -= frameTime;
+			if (state.frame + 1 < state.numFrames) {
+				state.frame++;
+			}
+			else if (state.loop) {
+				state.frame = 0;
+			}
+			else {
+				//hold the last frame so isDone() can't be missed on a long tick
+				state.stopped = true;
+				state.time = 0;
+				break;
+			}
+		}
+	}
+}
+
+void AnimationSystem::play(Animated& sprite, int clip, bool loop)
+{
+	AnimationState& state = getState(sprite);
+	sprite.animationIndex = clip;
+	if (state.clip != clip) {
+		startClip(state, sprite, clip, loop);
+	}
+	state.loop = loop;
+}
+
+void AnimationSystem::restart(Animated& sprite)
+{
+	AnimationState& state = getState(sprite);
+	state.frame = 0;
+	state.time = 0;
+	state.stopped = false;
+}
+
+void AnimationSystem::setPaused(Animated& sprite, bool paused)
+{
+	getState(sprite).paused = paused;
+}
+
+bool AnimationSystem::isDone(Animated& sprite)
+{
+	AnimationState& state = getState(sprite);
+	return state.frame == state.numFrames - 1;
+}
+
+int AnimationSystem::getFrame(Animated& sprite)
+{
+	return getState(sprite).frame;
+}
+
+void AnimationSystem::release(Animated& sprite)
+{
+	if (sprite.animationGeneration != generation || sprite.animationState < 0) {
+		return;
+	}
+	states[sprite.animationState].used = false;
+	freeStates.push_back(sprite.animationState);
+	sprite.animationState = -1;
+}
+
+void AnimationSystem::save(Animated& sprite, StateWriter& out)
+{
+	AnimationState& state = getState(sprite);
+	out.write<int32_t>(state.clip);
+	out.write<int32_t>(state.frame);
+	out.write(state.time);
+	uint8_t flags = (state.loop ? 1 : 0) | (state.paused ? 2 : 0) | (state.stopped ? 4 : 0);
+	out.write(flags);
+}
+
+bool AnimationSystem::load(Animated& sprite, StateReader& in)
+{
+	int32_t clip;
+	int32_t frame;
+	double time;
+	uint8_t flags;
+	if (!in.read(clip) || !in.read(frame) || !in.read(time) || !in.read(flags)) {
+		return false;
+	}
+	if (clip < 0 || clip >= (int)sprite.animations.size() || frame < 0 || frame >= sprite.animations[clip]->numFrames) {
+		return false;
+	}
+	//the clip's frame count and speed come from the shared definition, not the file
+	AnimationState& state = getState(sprite);
+	sprite.animationIndex = clip;
+	startClip(state, sprite, clip, flags & 1);
+	state.frame = frame;
+	state.time = time;
+	state.paused = flags & 2;
+	state.stopped = flags & 4;
+	return true;
+}
+
+void AnimationSystem::reset()
+{
+	states.clear();
+	freeStates.clear();
+	generation++;
+}
+
+int AnimationSystem::size()
+{
+	return states.size();
+}
+
+AnimationSystem* AnimationSystem::instance;
+
+AnimationSystem* AnimationSystem::getInstance()
+{
+	if (!instance) {
+		instance = new AnimationSystem();
+	}
+	return instance;
+}
+
+AnimationState& AnimationSystem::getState(Animated& sprite)
+{
+	if (sprite.animationGeneration == generation && sprite.animationState >= 0) {
+		return states[sprite.animationState];
+	}
+	int index;
+	if (!freeStates.empty()) {
+		index = freeStates.back();
+		freeStates.pop_back();
+	}
+	else {
+		index = states.size();
+		states.emplace_back();
+	}
+	sprite.animationState = index;
+	sprite.animationGeneration = generation;
+	startClip(states[index], sprite, sprite.animationIndex, true);
+	return states[index];
+}
+
+void AnimationSystem::startClip(AnimationState& state, const Animated& sprite, int clip, bool loop)
+{
+	state.clip = clip;
+	state.numFrames = 1;
+	state.framesPerSecond = 0;
+	if (clip >= 0 && clip < (int)sprite.animations.size()) {
+		state.numFrames = sprite.animations[clip]->numFrames;
+		state.framesPerSecond = sprite.animations[clip]->framesPerSecond;
+	}
+	state.time = 0;
+	state.frame = 0;
+	state.loop = loop;
+	state.paused = false;
+	state.stopped = false;
+	state.used = true;
+}
+
+AnimationSystem::AnimationSystem()
+{
+	//sprites start with generation 0, so every new sprite registers on first use
+	generation = 1;
+}
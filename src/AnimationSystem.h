@@ -0,0 +1,153 @@
+#pragma once
+#include <vector>
+#include "Animated.h"
+#include "SaveState.h"
+
+/**
+ * @struct AnimationState
+ * @brief Estado de reproducción de la animación de un sprite.
+ */
+struct AnimationState {
+    int clip;               ///< Índice de la animación que se reproduce dentro de `Animated::animations`.
+    int numFrames;          ///< Cuadros de la animación, copiados de la definición compartida.
+    double framesPerSecond; ///< Velocidad de la animación, copiada de la definición compartida.
+    double time;            ///< Tiempo transcurrido en el cuadro actual.
+    int frame;              ///< Cuadro actual.
+    bool loop;              ///< Si es false, la animación se detiene en el último cuadro.
+    bool paused;            ///< Si es true, la animación no avanza.
+    bool stopped;           ///< true cuando una animación sin bucle llegó al final.
+    bool used;              ///< false si el espacio está libre para reutilizarse.
+};
+
+/**
+ * @class AnimationSystem
+ * @brief Avanza todas las animaciones del juego una vez por tick.
+ *
+ * Los estados de reproducción de todos los sprites animados se guardan juntos en un
+ * arreglo contiguo y se avanzan en un solo recorrido con el tiempo de `GameClock`,
+ * en cuadros por segundo. Cada `Animated` guarda solo el índice de su estado; el dibujo
+ * lee el cuadro que la instantánea copió en `Animated::currentFrame`.
+ */
+class AnimationSystem {
+public:
+    /**
+     * @brief Avanza todas las animaciones activas, saltando las pausadas o detenidas.
+     *
+     * @param deltaTime Duración del tick en segundos.
+     */
+    void update(double deltaTime);
+
+    /**
+     * @brief Reproduce una animación del sprite.
+     *
+     * Si el sprite ya reproducía esa animación no hace nada; si no, empieza desde el primer cuadro.
+     *
+     * @param sprite Sprite animado.
+     * @param clip Índice de la animación en `sprite.animations`.
+     * @param loop Si la animación vuelve al primer cuadro al terminar.
+     */
+    void play(Animated& sprite, int clip, bool loop);
+
+    /**
+     * @brief Vuelve la animación actual del sprite al primer cuadro.
+     *
+     * @param sprite Sprite animado.
+     */
+    void restart(Animated& sprite);
+
+    /**
+     * @brief Pausa o reanuda la animación del sprite.
+     *
+     * @param sprite Sprite animado.
+     * @param paused true para pausar.
+     */
+    void setPaused(Animated& sprite, bool paused);
+
+    /**
+     * @brief Verifica si la animación actual llegó a su último cuadro.
+     *
+     * @param sprite Sprite animado.
+     * @return true si está en el último cuadro.
+     */
+    bool isDone(Animated& sprite);
+
+    /**
+     * @brief Obtiene el cuadro actual del sprite.
+     *
+     * @param sprite Sprite animado.
+     * @return Índice del cuadro.
+     */
+    int getFrame(Animated& sprite);
+
+    /**
+     * @brief Libera el estado de un sprite que se va a destruir.
+     *
+     * @param sprite Sprite animado.
+     */
+    void release(Animated& sprite);
+
+    /**
+     * @brief Guarda la animación que reproduce un sprite y en qué punto va.
+     *
+     * @param sprite Sprite animado.
+     * @param out Destino.
+     */
+    void save(Animated& sprite, StateWriter& out);
+
+    /**
+     * @brief Restaura en un sprite lo que guardó `save`.
+     *
+     * @param sprite Sprite animado, con sus animaciones ya asignadas.
+     * @param in Origen.
+     * @return false si faltaban datos.
+     */
+    bool load(Animated& sprite, StateReader& in);
+
+    /**
+     * @brief Descarta todos los estados, por ejemplo al reiniciar el juego.
+     *
+     * Los sprites que aún existan se vuelven a registrar la próxima vez que se usen.
+     */
+    void reset();
+
+    /**
+     * @brief Cantidad de espacios reservados en el arreglo de estados.
+     * @return Número de estados, libres o en uso.
+     */
+    int size();
+
+    /**
+     * @brief Obtiene la instancia única de `AnimationSystem`.
+     * @return Puntero a la instancia única.
+     */
+    static AnimationSystem* getInstance();
+
+private:
+    std::vector<AnimationState> states;  ///< Estados de todos los sprites, contiguos.
+    std::vector<int> freeStates;         ///< Espacios liberados que se reutilizan.
+    unsigned int generation;             ///< Aumenta en cada `reset` para invalidar índices viejos.
+    static AnimationSystem* instance;    ///< Instancia única de la clase (Singleton).
+
+    /**
+     * @brief Busca el estado del sprite, registrándolo si todavía no tiene uno válido.
+     *
+     * @param sprite Sprite animado.
+     * @return Estado de reproducción del sprite.
+     */
+    AnimationState& getState(Animated& sprite);
+
+    /**
+     * @brief Configura un estado para reproducir una animación desde el principio.
+     *
+     * @param state Estado a configurar.
+     * @param sprite Sprite dueño del estado.
+     * @param clip Índice de la animación.
+     * @param loop Si la animación se repite.
+     */
+    static void startClip(AnimationState& state, const Animated& sprite, int clip, bool loop);
+
+    /**
+     * @brief Constructor privado.
+     */
+    AnimationSystem();
+};
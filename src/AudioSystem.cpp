@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include "AudioSystem.h"
+#include "SoundManager.h"
+
+/**
+ * @struct SoundFile
+ * @brief Archivo y volumen base de cada `SoundId`.
+ */
+struct SoundFile {
+	const char* fileName; ///< Nombre del archivo en la carpeta de sonidos.
+	float volume;         ///< Volumen a distancia cero.
+};
+
+//indexed by SoundId
+static const SoundFile soundFiles[soundCount] = {
+	{ "walk.mp3", 1 },
+	{ "EnemyAttack.mp3", 1 },
+	{ "reload.mp3", 1 },
+	{ "heal.mp3", 1 },
+	{ "shoot.mp3", 0.5f },
+	{ "ammo.mp3", 1 },
+	{ "door_open.mp3", 1 },
+	{ "demon_attack.mp3", 1 },
+	{ "demon_hurt.mp3", 1 },
+	{ "demon_death.mp3", 1 },
+	{ "zombie_hurt.mp3", 1 },
+	{ "zombie_death.mp3", 1 },
+	{ "zombie_shoot.mp3", 1 },
+	{ "projectile_explode.mp3", 1 },
+};
+
+void AudioSystem::play(SoundId sound, int priority)
+{
+	emit({ sound, playAction, { 0, 0 }, false, priority });
+}
+
+void AudioSystem::playAt(SoundId sound, Point2D position, int priority)
+{
+	emit({ sound, playAction, position, true, priority });
+}
+
+void AudioSystem::playIfIdle(SoundId sound)
+{
+	emit({ sound, idleAction, { 0, 0 }, false, SOUND_PRIORITY_NORMAL });
+}
+
+void AudioSystem::stop(SoundId sound)
+{
+	emit({ sound, stopAction, { 0, 0 }, false, SOUND_PRIORITY_NORMAL });
+}
+
+void AudioSystem::update(Point2D listener)
+{
+	//resolve the file names once instead of on every event
+	if (sounds.empty()) {
+		SoundManager* soundManager = SoundManager::getInstance();
+		for (int i = 0; i < soundCount; i++) {
+			sounds.push_back(soundManager->getSound(soundFiles[i].fileName));
+		}
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		std::swap(pending, draining);
+	}
+
+	//one entry per sound: the latest stop wins, repeated plays collapse into the closest and most urgent
+	struct Resolved {
+		bool used;
+		SoundAction action;
+		double distance;
+		int priority;
+	};
+	Resolved resolved[soundCount] = {};
+	for (const SoundEvent& event : draining) {
+		Resolved& entry = resolved[event.sound];
+		double distance = 0;
+		if (event.positional) {
+			distance = hypot(event.position.x - listener.x, event.position.y - listener.y);
+		}
+		if (!entry.used || entry.action == stopAction || event.action == stopAction) {
+			entry = { true, event.action, distance, event.priority };
+		}
+		else {
+			if (event.action == playAction) {
+				entry.action = playAction;
+			}
+			entry.distance = std::min(entry.distance, distance);
+			entry.priority = std::max(entry.priority, event.priority);
+		}
+	}
+	draining.clear();
+
+	std::array<int, soundCount> order;
+	int count = 0;
+	for (int i = 0; i < soundCount; i++) {
+		if (!resolved[i].used) {
+			continue;
+		}
+		if (resolved[i].action == stopAction) {
+			StopSound(sounds[i]);
+		}
+		else {
+			order[count++] = i;
+		}
+	}
+	std::sort(order.begin(), order.begin() + count, [&resolved](int a, int b) {
+		if (resolved[a].priority != resolved[b].priority) {
+			return resolved[a].priority > resolved[b].priority;
+		}
+		return resolved[a].distance < resolved[b].distance;
+	});
+
+	int played = 0;
+	for (int k = 0; k < count && played < MAX_SOUNDS_PER_FRAME; k++) {
+		int i = order[k];
+		if (resolved[i].action == idleAction && IsSoundPlaying(sounds[i])) {
+			continue;
+		}
+		double attenuation = std::clamp(1 - resolved[i].distance / SOUND_FALLOFF_DISTANCE, SOUND_MIN_VOLUME, 1.0);
+		SetSoundVolume(sounds[i], soundFiles[i].volume * attenuation);
+		PlaySound(sounds[i]);
+		played++;
+	}
+}
+
+AudioSystem* AudioSystem::instance;
+
+AudioSystem* AudioSystem::getInstance()
+{
+	if (!instance) {
+		instance = new AudioSystem();
+	}
+	return instance;
+}
+
+void AudioSystem::emit(const SoundEvent& event)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	pending.push_back(event);
+}
+
+AudioSystem::AudioSystem()
+{
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <vector>
+#include <mutex>
+#include <raylib.h>
+#include "Point2D.h"
+#include "Enumerations.h"
+#define SOUND_PRIORITY_LOW 0
+#define SOUND_PRIORITY_NORMAL 1
+#define SOUND_PRIORITY_HIGH 2
+#define MAX_SOUNDS_PER_FRAME 8
+#define SOUND_FALLOFF_DISTANCE 30.0
+#define SOUND_MIN_VOLUME 0.2
+
+/**
+ * @struct SoundEvent
+ * @brief Pedido de sonido que hace la lógica del juego.
+ */
+struct SoundEvent {
+    SoundId sound;      ///< Sonido pedido.
+    SoundAction action; ///< Qué hacer con él.
+    Point2D position;   ///< Dónde ocurrió, si `positional`.
+    bool positional;    ///< false para sonidos del propio jugador, que suenan a volumen completo.
+    int priority;       ///< Los de mayor prioridad se reproducen primero si hay demasiados.
+};
+
+/**
+ * @class AudioSystem
+ * @brief Cola de eventos de sonido entre la lógica del juego y raylib.
+ *
+ * La lógica (en el hilo de simulación) no llama a `PlaySound`: anota eventos compactos
+ * con `play`, `playAt`, `playIfIdle` y `stop`. Una vez por cuadro `update` vacía la cola,
+ * junta los eventos repetidos del mismo sonido en uno solo (el más cercano y de mayor
+ * prioridad), reproduce como mucho `MAX_SOUNDS_PER_FRAME` y atenúa los que tienen
+ * posición según su distancia al oyente. La cola está protegida con un mutex, así que
+ * cualquier hilo puede anotar eventos.
+ */
+class AudioSystem {
+public:
+    /**
+     * @brief Pide reproducir un sonido del jugador, a volumen completo.
+     *
+     * @param sound Sonido.
+     * @param priority Prioridad del pedido.
+     */
+    void play(SoundId sound, int priority = SOUND_PRIORITY_NORMAL);
+
+    /**
+     * @brief Pide reproducir un sonido que ocurre en una posición del mundo.
+     *
+     * @param sound Sonido.
+     * @param position Posición donde ocurre.
+     * @param priority Prioridad del pedido.
+     */
+    void playAt(SoundId sound, Point2D position, int priority = SOUND_PRIORITY_NORMAL);
+
+    /**
+     * @brief Pide reproducir un sonido solo si no está sonando ya.
+     *
+     * @param sound Sonido.
+     */
+    void playIfIdle(SoundId sound);
+
+    /**
+     * @brief Pide detener un sonido.
+     *
+     * @param sound Sonido.
+     */
+    void stop(SoundId sound);
+
+    /**
+     * @brief Procesa los eventos anotados desde el último cuadro.
+     *
+     * Debe llamarse desde el hilo que inicializó el dispositivo de audio.
+     *
+     * @param listener Posición del oyente (el jugador dibujado).
+     */
+    void update(Point2D listener);
+
+    /**
+     * @brief Obtiene la instancia única de `AudioSystem`.
+     * @return Puntero a la instancia única.
+     */
+    static AudioSystem* getInstance();
+
+private:
+    std::mutex mutex;                  ///< Protege `pending`.
+    std::vector<SoundEvent> pending;   ///< Eventos anotados desde el último `update`.
+    std::vector<SoundEvent> draining;  ///< Eventos que está procesando `update`, reutilizado.
+    std::vector<Sound> sounds;         ///< Sonido de raylib de cada `SoundId`.
+    static AudioSystem* instance;      ///< Instancia única de la clase (Singleton).
+
+    /**
+     * @brief Anota un evento en la cola.
+     *
+     * @param event Evento.
+     */
+    void emit(const SoundEvent& event);
+
+    /**
+     * @brief Constructor privado; los sonidos se buscan en el primer `update`.
+     */
+    AudioSystem();
+};
@@ -3,11 +3,10 @@
 #include <iostream>
 #include <algorithm>
 #include "Canvas.h"
+#include "rlgl.h"
 #include "Drawable.h"
-#include "Enemy.h"
 #include "EnemyManager.h"
 #include "Lamp.h"
-#include "RangedEnemy.h"
 #include "Game.h"
 
 Canvas::Canvas()
@@ -18,14 +17,32 @@ Canvas::Canvas()
 	windowHeight = 0;
 	halfWindowHeight = 0;
 	halfWindowWidth = 0;
+	viewWidth = 0;
+	viewHeight = 0;
+	halfViewWidth = 0;
+	halfViewHeight = 0;
+	resolutionScale = 1;
+	frameTimeSum = 0;
+	workTimeSum = 0;
+	sampledFrames = 0;
+	viewTarget = {};
+	hudLayer = {};
+	pauseLayer = {};
+	optionsLayer = {};
+	transitionLayer = {};
 	FOV = 0;
 	halfFOV = 0;
 	screenDist = 0;
 	scale = 0;
+	viewCos = 1;
+	viewSin = 0;
 	rayCaster = RayCaster();
 	backgroundOffset = 0;
 	darkness = 0;
+	surfaceMipLevels = 0;
+	renderBackend = gpuRendering;
 	textureManager = TextureManager::getInstance();
+	lightMap = LightMap::getInstance();
 }
 
 Canvas::Canvas(int width, int height)
@@ -39,14 +56,22 @@ Canvas::Canvas(int width, int height)
 
 	FOV = PI / 3;
 	halfFOV = FOV / 2;
-	screenDist = halfWindowWidth / tan(halfFOV);
-
-	int numRays = windowWidth / 2;
-	double deltaAngle = FOV / numRays;
-	rayCaster = RayCaster(numRays, deltaAngle);
-	scale = windowWidth / numRays;
+	frameTimeSum = 0;
+	workTimeSum = 0;
+	sampledFrames = 0;
+	viewTarget = {};
+	hudLayer = {};
+	pauseLayer = {};
+	optionsLayer = {};
+	transitionLayer = {};
+	setResolutionScale(1);
+	viewCos = 1;
+	viewSin = 0;
 	darkness = 0.00013;
+	surfaceMipLevels = 0;
+	renderBackend = gpuRendering;
 	textureManager = TextureManager::getInstance();
+	lightMap = LightMap::getInstance();
 
 	backgroundOffset = 0;
 }
@@ -55,13 +80,19 @@ void Canvas::startWindow()
 {
 	InitWindow(windowWidth, windowHeight, "THE PURIFIER OF SOULS");
 	textureManager->loadTexturesToVRAM();
+	for (int id = none; id <= openDoor; id++) {
+		wallMipChains.push_back(textureManager->getMipChain(getWallTexture(WallType(id))));
+		surfaceMipLevels = std::max(surfaceMipLevels, (int)wallMipChains.back().size());
+	}
+	surfaceBatches.resize(wallMipChains.size() * surfaceMipLevels);
 	SetWindowState(FLAG_VSYNC_HINT);
-	SetTargetFPS(60);
+	SetTargetFPS(TARGET_FPS);
 	DisableCursor();
+	setResolutionScale(resolutionScale);
 
 	titleFont = LoadFontEx("assets/fonts/AmazDooMLeft.ttf", 500, nullptr, 0);
 }
-GameState Canvas::draw(const Map& map, Player& player, ItemManager& objManager, EnemyManager& enemyManager, GameState state)
+GameState Canvas::draw(RenderSnapshot& snapshot, GameState state)
 {
 	GameState newState = na;
 	BeginDrawing();
@@ -77,10 +108,14 @@ GameState Canvas::draw(const Map& map, Player& player, ItemManager& objManager,
 		break;
 
 	case playing:
+	{
 		DisableCursor();
-		draw3D(player, map, objManager, enemyManager);
-		drawHUD(player);
+		double workStart = GetTime();
+		draw3D(snapshot);
+		drawHUD(snapshot.player);
+		updateResolutionScale(GetTime() - workStart);
 		break;
+	}
 
 	case gameOver:
 		DrawText("Nice Try", 250, 300, 100, RED);
@@ -102,12 +137,69 @@ GameState Canvas::draw(const Map& map, Player& player, ItemManager& objManager,
 
 
 
-void Canvas::draw3D(const Player& player, const Map& map, ItemManager& objManager, EnemyManager& enemyManager)
+void Canvas::setResolutionScale(double resolutionScale)
 {
-	drawBackground(player);
+	this->resolutionScale = resolutionScale;
+	viewWidth = windowWidth * resolutionScale;
+	viewHeight = windowHeight * resolutionScale;
+	halfViewWidth = viewWidth / 2;
+	halfViewHeight = viewHeight / 2;
+	screenDist = halfViewWidth / tan(halfFOV);
+
+	int numRays = viewWidth / 2;
+	double deltaAngle = FOV / numRays;
+	rayCaster = RayCaster(numRays, deltaAngle);
+	scale = viewWidth / numRays;
+
+	if (IsWindowReady()) {
+		if (viewTarget.id != 0) {
+			UnloadRenderTexture(viewTarget);
+		}
+		viewTarget = LoadRenderTexture(viewWidth, viewHeight);
+		SetTextureFilter(viewTarget.texture, TEXTURE_FILTER_BILINEAR);
+		if (softwareRenderer.isReady()) {
+			softwareRenderer.init(numRays, (int)(viewHeight / scale));
+		}
+	}
+}
+
+void Canvas::updateResolutionScale(double workTime)
+{
+	frameTimeSum += GetFrameTime();
+	workTimeSum += workTime;
+	sampledFrames++;
+	if (sampledFrames < RESOLUTION_SAMPLE_FRAMES) {
+		return;
+	}
+	double frameTime = frameTimeSum / sampledFrames;
+	double work = workTimeSum / sampledFrames;
+	frameTimeSum = 0;
+	workTimeSum = 0;
+	sampledFrames = 0;
+
+	//the frame rate cap hides spare time, so only scale up when drawing itself is well under budget
+	double budget = 1.0 / TARGET_FPS;
+	if (frameTime > budget * 1.1 && resolutionScale > MIN_RESOLUTION_SCALE) {
+		setResolutionScale(std::max(MIN_RESOLUTION_SCALE, resolutionScale - RESOLUTION_SCALE_STEP));
+	}
+	else if (frameTime < budget * 1.05 && work < budget * 0.5 && resolutionScale < 1) {
+		setResolutionScale(std::min(1.0, resolutionScale + RESOLUTION_SCALE_STEP));
+	}
+}
+
+void Canvas::draw3D(RenderSnapshot& snapshot)
+{
+	const Player& player = snapshot.player;
+	const Map& map = snapshot.map;
+	BeginTextureMode(viewTarget);
+	ClearBackground(BLACK);
+	drawBackground(player, map);
 
 	//add walls to queue
 	double rayAngle = player.angle - (halfFOV) + 0.0001;
+	if (renderBackend == cpuRendering) {
+		beginSoftwareFrame(player, map, rayAngle);
+	}
 	auto rays = rayCaster.getAllRays(rayAngle, player, map);
 	for (auto& ray : rays) {
 		Drawable* casted = &ray;
@@ -115,33 +207,38 @@ void Canvas::draw3D(const Player& player, const Map& map, ItemManager& objManage
 	}
 	rayCaster.clearRays();
 
-	//add Items to draw queue
-	auto items = objManager.getCurrentItemList();
-	for (auto& obj : *items) {
-		obj->sprite->depth = obj->sprite->getDistanceFromPlayer(obj->position, player);
-		Drawable* casted = obj->sprite;
-		drawQueue.push_back(casted);
-	}
-	
-	//add enemies to draw queue
-	auto enemies = enemyManager.getEnemyList();
-	for (auto& enemy: *enemies){
-		enemy->sprite->depth = enemy->sprite->getDistanceFromPlayer(enemy->position, player);
-		enemy->sprite->position = enemy->position;
-		drawQueue.push_back(enemy->sprite);
-		//add projectile to draw queue if enemy can shoot projectiles
-		auto ranged = dynamic_cast<RangedEnemy*>(enemy);
-		if (ranged) {
-			for (auto proj : ranged->getProjectiles()) {
-				if (proj) {
-					proj->sprite->position = proj->getPosition();
-					proj->sprite->depth = proj->sprite->getDistanceFromPlayer(proj->getPosition(), player);
-					drawQueue.push_back(proj->sprite);
-				}
-			}
+	//add visible Items to draw queue
+	double fogDistance = getFogDistance();
+	viewCos = cos(player.angle);
+	viewSin = sin(player.angle);
+	for (auto& sprite : snapshot.staticSprites) {
+		if (isSpriteVisible(sprite.position, rays, player, fogDistance)) {
+			spriteBuffer.add(&sprite);
 		}
 	}
 
+	//add visible animated sprites (lamps, enemies and projectiles) to draw queue
+	for (auto& sprite : snapshot.animatedSprites) {
+		if (isSpriteVisible(sprite.position, rays, player, fogDistance)) {
+			spriteBuffer.add(&sprite);
+		}
+	}
+
+	//project every gathered sprite in one pass and queue the ones that land on screen
+	SpriteView spriteView = { player.position, player.angle, screenDist, rayCaster.getDeltaAngle(),
+		rayCaster.getNumRays() / 2, scale, viewWidth, halfViewHeight };
+	spriteBuffer.project(spriteView);
+	for (int i = 0; i < spriteBuffer.size(); i++) {
+		Drawable* sprite = spriteBuffer.owner[i];
+		if (!spriteBuffer.onScreen[i]) {
+			continue;
+		}
+		sprite->depth = spriteBuffer.distance[i];
+		sprite->positionOnWindow = { spriteBuffer.posX[i], spriteBuffer.posY[i], spriteBuffer.projWidth[i], spriteBuffer.projHeight[i] };
+		drawQueue.push_back(sprite);
+	}
+	spriteBuffer.clear();
+
 	//sort queue by distance from player && draw
 	std::sort(drawQueue.begin(), drawQueue.end(), [](const Drawable* a, const Drawable* b) { return a->depth > b->depth; });
 	RayCastResult* rayPtr;
@@ -155,113 +252,114 @@ void Canvas::draw3D(const Player& player, const Map& map, ItemManager& objManage
 			drawColumn(*rayPtr);
 		}
 		else if (animatedPtr) {
-			drawAnimatedSprite(*animatedPtr, player);
+			drawAnimatedSprite(*animatedPtr);
 		}
 		else if (spritePtr) {
-			drawStaticSprite(*spritePtr, player);
+			drawStaticSprite(*spritePtr);
 		}
 	}
 	drawQueue.clear();
+	if (softwareRenderer.isFrameOpen()) {
+		softwareRenderer.endFrame({ 0, 0, (float)viewWidth, (float)viewHeight });
+	}
+	EndTextureMode();
+
+	//render textures are stored upside down
+	Rectangle viewSource = { 0, 0, (float)viewWidth, -(float)viewHeight };
+	Rectangle viewDest = { 0, 0, (float)windowWidth, (float)windowHeight };
+	DrawTexturePro(viewTarget.texture, viewSource, viewDest, { 0,0 }, 0, WHITE);
 
 	drawWeapon(*player.weapon);
 	drawBlood(player);
 }
 
-
-void Canvas::drawStaticSprite(Drawable sprite, Player player)
+double Canvas::getFogDistance()
 {
-	//difference between player position && Item position;
-	Point2D d;
-	d.x = sprite.position.x - player.position.x;
-	d.y = sprite.position.y - player.position.y;
-	double angleToSprite = atan2(d.y, d.x);
-
-	//angle from player direction to sprite
-	double delta = angleToSprite - player.angle;
-	if ((d.x > 0 && player.angle > PI) || (d.x < 0 && d.y < 0)) {
-		delta += PI * 2;
-	}
-
-	double deltaRays = delta / rayCaster.getDeltaAngle();
-	auto halfNumRays = rayCaster.getNumRays() / 2;
-	int screenPosX = (halfNumRays + deltaRays) * scale;
-
-	double dist = sprite.getDistanceFromPlayer(sprite.position, player);
-
-	if ((-sprite.tex.width < screenPosX) && (screenPosX < (windowWidth + sprite.tex.width)) && dist > 0.0) {
-		double imgRatio = (float)sprite.tex.width / (float)sprite.tex.height;
-		double proj = screenDist / dist * sprite.scale;
-		double projWidth = proj * imgRatio;
-		double projHeight = proj;
-		double halfWidth = projWidth / 2;
-		double posX = screenPosX - halfWidth;
-		double heightShift = projHeight * sprite.shift;
-		double posY = halfWindowHeight - projHeight / 2 + heightShift;
-		sprite.textureArea = { 0,0, (float)sprite.tex.width, (float)sprite.tex.height };
-		sprite.positionOnWindow = { (float)(posX), (float)(posY), (float)(projWidth), (float)(projHeight) };
-		Color textureColor = WHITE;
-		textureColor.r = 225 / (1 + pow(sprite.depth, 5) * darkness);
-		textureColor.g = 225 / (1 + pow(sprite.depth, 5) * darkness);
-		textureColor.b = 225 / (1 + pow(sprite.depth, 5) * darkness);
-		DrawTexturePro(sprite.tex, sprite.textureArea, sprite.positionOnWindow, { 0,0 }, 0, textureColor);
+	//225 / (1 + depth^5 * darkness) drops below 1 past this distance
+	if (darkness <= 0) {
+		return -1;
 	}
+	return pow(224 / darkness, 1.0 / 5.0);
 }
 
-void Canvas::drawAnimatedSprite(Animated& sprite, Player player)
+bool Canvas::isSpriteVisible(Point2D position, const std::vector<RayCastResult>& rays, const Player& player, double fogDistance)
 {
-	//difference between player position && Item position;
 	Point2D d;
-	d.x = sprite.position.x - player.position.x;
-	d.y = sprite.position.y - player.position.y;
-	double angleToSprite = atan2(d.y, d.x);
-
-	//angle from player direction to sprite
-	double delta = angleToSprite - player.angle;
-	if ((d.x > 0 && player.angle > PI) || (d.x < 0 && d.y < 0)) {
-		delta += PI * 2;
+	d.x = position.x - player.position.x;
+	d.y = position.y - player.position.y;
+
+	//beyond the fog, unless a lamp lights it up
+	double distSquared = d.x * d.x + d.y * d.y;
+	double maxDist = fogDistance + SPRITE_CULL_RADIUS;
+	if (fogDistance >= 0 && distSquared > maxDist * maxDist && lightMap->getLight(position.x, position.y) == 0) {
+		return false;
+	}
+
+	//outside the FOV cone, in camera space
+	double forward = d.x * viewCos + d.y * viewSin;
+	double side = d.y * viewCos - d.x * viewSin;
+	if (forward < -SPRITE_CULL_RADIUS) {
+		return false;
+	}
+	if (std::abs(side) > forward * tan(halfFOV) + SPRITE_CULL_RADIUS / cos(halfFOV)) {
+		return false;
+	}
+
+	//hidden behind the walls hit by the columns the sprite could cover
+	if (rays.empty() || forward <= SPRITE_CULL_RADIUS) {
+		return true;
+	}
+	double deltaAngle = rayCaster.getDeltaAngle();
+	double centerColumn = rayCaster.getNumRays() / 2 + atan2(side, forward) / deltaAngle;
+	double halfColumns = atan(SPRITE_CULL_RADIUS / forward) / deltaAngle;
+	int first = std::max(0, (int)(centerColumn - halfColumns));
+	int last = std::min((int)rays.size() - 1, (int)(centerColumn + halfColumns));
+	double nearestEdge = forward - SPRITE_CULL_RADIUS;
+	for (int column = first; column <= last; column++) {
+		if (rays[column].depth > nearestEdge) {
+			return true;
+		}
 	}
+	return false;
+}
 
-	double deltaRays = delta / rayCaster.getDeltaAngle();
-	auto halfNumRays = rayCaster.getNumRays() / 2;
-	int screenPosX = (halfNumRays + deltaRays) * scale;
-
-	double dist = sprite.getDistanceFromPlayer(sprite.position, player);
+void Canvas::drawStaticSprite(Drawable& sprite)
+{
+	//positionOnWindow was filled in by the projection pass in draw3D
+	sprite.textureArea = { 0,0, (float)sprite.tex.width, (float)sprite.tex.height };
+	Color textureColor = getLitColor(sprite.depth, sprite.position);
+	drawWorldTexture(sprite.tex, sprite.textureArea, sprite.positionOnWindow, textureColor);
+}
 
+void Canvas::drawAnimatedSprite(Animated& sprite)
+{
 	int& index = sprite.animationIndex;
 
-	if (index > sprite.animations.size() - 1) {
-		drawStaticSprite(sprite, player);
+	if (sprite.animations.empty() || index < 0 || index >= (int)sprite.animations.size()) {
+		drawStaticSprite(sprite);
 		return;
 	}
 
-	Animation& current = sprite.animations[sprite.animationIndex];
-
-	if ((-current.texture.width < screenPosX) && (screenPosX < (windowWidth + current.texture.width)) && dist > 0.0) {
-		double imgRatio = (float)current.texture.width / (float)current.texture.height;
-		double proj = screenDist / dist * sprite.scale;
-		double projWidth = proj * imgRatio / current.numFrames;
-		double projHeight = proj;
-		double halfWidth = projWidth / 2;
-		double posX = screenPosX - halfWidth;
-		double heightShift = projHeight * sprite.shift;
-		double posY = halfWindowHeight - projHeight / 2 + heightShift;
-		current.textureArea = { 0,0, (float)current.texture.width, (float)current.texture.height };
-		current.positionOnWindow = { (float)(posX), (float)(posY), (float)(projWidth), (float)(projHeight) };
-
-		sprite.isOnScreenCenter = (halfWindowWidth - current.positionOnWindow.width) < posX 
-							&& posX < (halfWindowWidth + current.positionOnWindow.width);
-
-		Color textureColor = WHITE;
-		if (current.texture.id != textureManager->getTexture("sprites/animated/lamp.png").id) {
-			textureColor.r = 225 / (1 + pow(sprite.depth, 5) * darkness);
-			textureColor.g = 225 / (1 + pow(sprite.depth, 5) * darkness);
-			textureColor.b = 225 / (1 + pow(sprite.depth, 5) * darkness);
-		}
-		animate(sprite, index, textureColor);
+	const Animation* current = sprite.animations[sprite.animationIndex];
+	Color textureColor = WHITE;
+	if (current->texture.id != textureManager->getTexture("sprites/animated/lamp.png").id) {
+		textureColor = getLitColor(sprite.depth, sprite.position);
 	}
+	animate(sprite, index, sprite.positionOnWindow, textureColor);
 }
 
 void Canvas::drawHUD(Player& player)
+{
+	LayerKey hudKey = { (double)player.weapon->ammoCount, (double)player.getHealth(), (double)player.getMaxHealth(),
+		(double)player.weapon->reloading, (double)GetScreenWidth(), (double)GetScreenHeight() };
+	if (beginLayer(hudLayer, hudKey)) {
+		drawHUDContents(player);
+		EndTextureMode();
+	}
+	drawLayer(hudLayer);
+}
+
+void Canvas::drawHUDContents(Player& player)
 {
 	// 1. Cargar y dibujar la textura del HUD
 	Texture hudTexture = textureManager->getTexture("sprites/static/hudgun.png");
@@ -340,58 +438,103 @@ void Canvas::drawHUD(Player& player)
 
 
 
-void Canvas::drawColumn(RayCastResult ray)
+void Canvas::beginSoftwareFrame(const Player& player, const Map& map, double firstRayAngle)
 {
-	Color wallColor = WHITE;
-	wallColor.r = 225 / (1 + pow(ray.depth, 5) * darkness);
-	wallColor.g = 225 / (1 + pow(ray.depth, 5) * darkness);
-	wallColor.b = 225 / (1 + pow(ray.depth, 5) * darkness);
-
-	double projectionHeight = screenDist / (ray.depth + 0.0001);
+	if (!softwareRenderer.isReady()) {
+		softwareRenderer.init(rayCaster.getNumRays(), (int)(viewHeight / scale));
+		softwareRenderer.loadTextures(textureManager->getLoadedTextures());
+		std::vector<Texture> surfaceTextures;
+		for (int id = none; id <= openDoor; id++) {
+			surfaceTextures.push_back(id == none ? Texture{} : getWallTexture(WallType(id)));
+		}
+		softwareRenderer.setSurfaceTextures(surfaceTextures);
+	}
+	softwareRenderer.beginFrame(darkness);
+	softwareRenderer.setView(player.position, player.angle, firstRayAngle, rayCaster.getDeltaAngle(), screenDist / scale,
+		map.getFloorGrid(), map.getCeilingGrid(), lightMap);
+}
 
-	Texture columnTexture;
-	switch (ray.wall) {
+Texture Canvas::getWallTexture(WallType wall)
+{
+	switch (wall) {
 	case brick:
-		columnTexture = textureManager->getTexture("walls/brick.png");
-		break;
+		return textureManager->getTexture("walls/brick.png");
 	case stone:
-		columnTexture = textureManager->getTexture("walls/stone.png");
-		break;
+		return textureManager->getTexture("walls/stone.png");
 	case mossyStone:
-		columnTexture = textureManager->getTexture("walls/mossy_stone.png");
-		break;
+		return textureManager->getTexture("walls/mossy_stone.png");
 	case closedDoor:
-		columnTexture = textureManager->getTexture("walls/door.png");
-		break;
+	case openDoor:
+		return textureManager->getTexture("walls/door.png");
 	default:
-		columnTexture = textureManager->getTexture("");
-		break;
+		return textureManager->getTexture("");
 	}
+}
+
+Color Canvas::getLitColor(double depth, Point2D position)
+{
+	int shade = 225 / (1 + pow(depth, 5) * darkness);
+	unsigned char lit = (unsigned char)std::min(255, shade + lightMap->getLight(position.x, position.y));
+	return { lit, lit, lit, 255 };
+}
+
+void Canvas::drawWorldTexture(Texture texture, Rectangle source, Rectangle dest, Color tint)
+{
+	if (softwareRenderer.isFrameOpen()) {
+		Rectangle scaled = { (float)(dest.x / scale), (float)(dest.y / scale), (float)(dest.width / scale), (float)(dest.height / scale) };
+		softwareRenderer.drawSprite(texture, source, scaled, tint);
+	}
+	else {
+		//pick the mip level from how much the sprite is shrunk on screen
+		Texture level = textureManager->getMipLevel(texture, source.height / dest.height);
+		float ratioX = (float)level.width / texture.width;
+		float ratioY = (float)level.height / texture.height;
+		Rectangle levelSource = { source.x * ratioX, source.y * ratioY, source.width * ratioX, source.height * ratioY };
+		DrawTexturePro(level, levelSource, dest, { 0,0 }, 0, tint);
+	}
+}
+
+void Canvas::drawColumn(RayCastResult ray)
+{
+	//the light in front of the wall face, not inside the wall cell
+	Point2D litPoint = { ray.hitCoordinates.x - ray.cos * 0.01, ray.hitCoordinates.y - ray.sin * 0.01 };
+	Color wallColor = getLitColor(ray.depth, litPoint);
+
+	double projectionHeight = screenDist / (ray.depth + 0.0001);
+
+	const std::vector<Texture>& chain = wallMipChains[ray.wall < (int)wallMipChains.size() ? ray.wall : none];
+	Texture columnTexture = chain[0];
 
 	if (ray.horizontalTextureOffset > columnTexture.width) {
 		ray.horizontalTextureOffset = 0;
 	}
-	Rectangle source = { ray.horizontalTextureOffset * (columnTexture.width - scale), 0, scale, columnTexture.height };
-	Rectangle dest = { ray.index * scale, halfWindowHeight - (projectionHeight / 2), scale, projectionHeight };
+	if (softwareRenderer.isFrameOpen()) {
+		softwareRenderer.drawWallColumn(columnTexture, ray.index, ray.horizontalTextureOffset, projectionHeight / scale, ray.depth,
+			lightMap->getLight(litPoint.x, litPoint.y));
+		return;
+	}
+
+	//distant columns sample a smaller mip so the strip doesn't alias
+	Texture levelTexture = chain[TextureManager::getMipLevelIndex(columnTexture.height / projectionHeight, chain.size())];
+	float ratio = (float)levelTexture.width / columnTexture.width;
+	Rectangle source = { (float)(ray.horizontalTextureOffset * (columnTexture.width - scale) * ratio), 0, (float)(scale * ratio), (float)levelTexture.height };
+	Rectangle dest = { (float)(ray.index * scale), (float)(halfViewHeight - projectionHeight / 2), (float)scale, (float)projectionHeight };
 	ray.textureArea = source;
 	ray.positionOnWindow = dest;
-	DrawTexturePro(columnTexture, ray.textureArea, ray.positionOnWindow, { 0,0 }, 0.f, wallColor);
+	DrawTexturePro(levelTexture, ray.textureArea, ray.positionOnWindow, { 0,0 }, 0.f, wallColor);
 }
 
 void Canvas::drawWeapon(Weapon& weapon)
 {
 	int& index = weapon.sprite->animationIndex;
-	Animation& anim = weapon.sprite->animations[index];
-	if (weapon.reloading && !anim.isAnimationDone()) {
-		anim.positionOnWindow.x = (float)(halfWindowWidth * 0.8);
-		anim.positionOnWindow.y = (float)(windowHeight - anim.texture.height);
-		animate(*weapon.sprite, 0, WHITE);
-		if (anim.isAnimationDone()) {
-			weapon.reloading = false;
-		}
+	const Animation* anim = weapon.sprite->animations[index];
+	if (weapon.reloading) {
+		Rectangle dest = anim->frames[0];
+		dest.x = (float)(halfWindowWidth * 0.8);
+		dest.y = (float)(windowHeight - anim->texture.height);
+		animate(*weapon.sprite, 0, dest, WHITE);
 	}
 	else {
-		anim.resetAnimation();
 		Texture& shotgun = weapon.sprite->tex;
 		weapon.sprite->positionOnWindow.x = (float)(halfWindowWidth * 0.8);
 		weapon.sprite->positionOnWindow.y = (float)(windowHeight - shotgun.height);
@@ -399,7 +542,7 @@ void Canvas::drawWeapon(Weapon& weapon)
 	}
 }
 
-void Canvas::drawBackground(Player player)
+void Canvas::drawBackground(Player player, const Map& map)
 {
 	Texture background = textureManager->getTexture("backgrounds/fog.png");
 	if (player.isAlive()) {
@@ -409,15 +552,142 @@ void Canvas::drawBackground(Player player)
 	if (backgroundOffset > background.width) {
 		backgroundOffset = 0;
 	}
-	Rectangle source = { backgroundOffset, 0, background.width, background.height };
-	Rectangle dest = { 0, 0, windowWidth, halfWindowHeight };
+	Rectangle source = { (float)backgroundOffset, 0, (float)background.width, (float)background.height };
+	Rectangle dest = { 0, 0, (float)viewWidth, (float)halfViewHeight };
 	Color shadow = { 30, 30, 20 ,255 };
 	shadow.r = 225 / (1 + pow(9, 5) * darkness);
 	shadow.g = 225 / (1 + pow(9,5) * darkness);
 	shadow.b = 225 / (1 + pow(9,5) * darkness);
 	Color grass = { 30, 30, 20 ,255 };
 	DrawTexturePro(background, source, dest, { 0,0 }, 0, shadow);
-	DrawRectangleGradientV(0, halfWindowHeight, windowWidth, halfWindowHeight, BLACK, grass);
+	DrawRectangleGradientV(0, halfViewHeight, viewWidth, halfViewHeight, BLACK, grass);
+	//the software renderer casts its own floor and ceiling over the whole view
+	if (renderBackend == gpuRendering) {
+		castSurfaces(player, map);
+	}
+}
+
+void Canvas::castSurfaces(const Player& player, const Map& map)
+{
+	for (auto& batch : surfaceBatches) {
+		batch.clear();
+	}
+
+	//exact ray directions at the edges of each strip, the cells in between are interpolated
+	int numRays = rayCaster.getNumRays();
+	int strips = (numRays + SURFACE_STRIP_RAYS - 1) / SURFACE_STRIP_RAYS;
+	double firstRayAngle = player.angle - halfFOV + 0.0001;
+	stripDirections.resize(strips + 1);
+	for (int strip = 0; strip <= strips; strip++) {
+		double rayAngle = firstRayAngle + std::min(strip * SURFACE_STRIP_RAYS, numRays) * rayCaster.getDeltaAngle();
+		double correction = cos(rayAngle - player.angle);
+		stripDirections[strip] = { cos(rayAngle) / correction, sin(rayAngle) / correction };
+	}
+
+	//rows at the same distance from the horizon see the floor and ceiling at the same depth
+	for (int row = 0; row < halfViewHeight; row++) {
+		double depth = screenDist / (2 * (row + 0.5));
+		if (depth > SURFACE_MAX_DEPTH) {
+			continue;
+		}
+		int shade = (int)(225 / (1 + pow(depth, 5) * darkness));
+		for (int strip = 0; strip < strips; strip++) {
+			const Point2D& left = stripDirections[strip];
+			const Point2D& right = stripDirections[strip + 1];
+			Point2D start = { player.position.x + depth * left.x, player.position.y + depth * left.y };
+			Point2D end = { player.position.x + depth * right.x, player.position.y + depth * right.y };
+			float x0 = (float)(strip * SURFACE_STRIP_RAYS * scale);
+			float x1 = (float)(std::min((strip + 1) * SURFACE_STRIP_RAYS, numRays) * scale);
+			addSurfaceSpans(start, end, x0, x1, row, depth, shade, map.getFloorGrid(), map.getCeilingGrid());
+		}
+	}
+
+	//one texture switch per texture and mip level instead of one per span
+	for (int i = 0; i < (int)surfaceBatches.size(); i++) {
+		if (surfaceBatches[i].empty()) {
+			continue;
+		}
+		rlSetTexture(wallMipChains[i / surfaceMipLevels][i % surfaceMipLevels].id);
+		rlBegin(RL_QUADS);
+		for (const SurfaceSpan& span : surfaceBatches[i]) {
+			rlCheckRenderBatchLimit(4);
+			rlColor4ub(span.light0, span.light0, span.light0, 255);
+			rlTexCoord2f(span.u0, span.v0);
+			rlVertex2f(span.x0, span.y);
+			rlTexCoord2f(span.u0, span.v0);
+			rlVertex2f(span.x0, span.y + 1);
+			rlColor4ub(span.light1, span.light1, span.light1, 255);
+			rlTexCoord2f(span.u1, span.v1);
+			rlVertex2f(span.x1, span.y + 1);
+			rlTexCoord2f(span.u1, span.v1);
+			rlVertex2f(span.x1, span.y);
+		}
+		rlEnd();
+		rlSetTexture(0);
+	}
+}
+
+void Canvas::addSurfaceSpans(Point2D start, Point2D end, float x0, float x1, int row, double depth, int shade,
+	WallType** floorGrid, WallType** ceilingGrid)
+{
+	//split the strip where it crosses a cell border so each span samples a single cell
+	surfaceCrossings.clear();
+	surfaceCrossings.push_back(0);
+	surfaceCrossings.push_back(1);
+	double dx = end.x - start.x;
+	double dy = end.y - start.y;
+	for (double border = std::ceil(std::min(start.x, end.x)); border < std::max(start.x, end.x); border++) {
+		surfaceCrossings.push_back((border - start.x) / dx);
+	}
+	for (double border = std::ceil(std::min(start.y, end.y)); border < std::max(start.y, end.y); border++) {
+		surfaceCrossings.push_back((border - start.y) / dy);
+	}
+	std::sort(surfaceCrossings.begin(), surfaceCrossings.end());
+
+	for (int i = 0; i + 1 < (int)surfaceCrossings.size(); i++) {
+		double t0 = surfaceCrossings[i];
+		double t1 = surfaceCrossings[i + 1];
+		double middle = (t0 + t1) / 2;
+		int column = (int)std::floor(start.x + dx * middle);
+		int cellRow = (int)std::floor(start.y + dy * middle);
+		if (t1 <= t0 || column < 0 || cellRow < 0 || column >= GRID_SIZE || cellRow >= GRID_SIZE) {
+			continue;
+		}
+		WallType floorId = floorGrid[cellRow][column];
+		WallType ceilingId = ceilingGrid[cellRow][column];
+		if (floorId == none && ceilingId == none) {
+			continue;
+		}
+		//keep both ends inside the cell so its texture and light are the ones sampled
+		double u0 = std::clamp(start.x + dx * t0 - column, 0.0, 1.0);
+		double v0 = std::clamp(start.y + dy * t0 - cellRow, 0.0, 1.0);
+		double u1 = std::clamp(start.x + dx * t1 - column, 0.0, 1.0);
+		double v1 = std::clamp(start.y + dy * t1 - cellRow, 0.0, 1.0);
+		SurfaceSpan span;
+		span.x0 = (float)(x0 + (x1 - x0) * t0);
+		span.x1 = (float)(x0 + (x1 - x0) * t1);
+		span.u0 = (float)u0;
+		span.v0 = (float)v0;
+		span.u1 = (float)u1;
+		span.v1 = (float)v1;
+		span.light0 = (unsigned char)std::min(255, shade + lightMap->getLight(column + std::min(u0, 0.999), cellRow + std::min(v0, 0.999)));
+		span.light1 = (unsigned char)std::min(255, shade + lightMap->getLight(column + std::min(u1, 0.999), cellRow + std::min(v1, 0.999)));
+		span.y = (float)(halfViewHeight + row);
+		addSurfaceSpan(floorId, span, depth);
+		span.y = (float)(halfViewHeight - 1 - row);
+		addSurfaceSpan(ceilingId, span, depth);
+	}
+}
+
+void Canvas::addSurfaceSpan(WallType id, const SurfaceSpan& span, double depth)
+{
+	if (id == none) {
+		return;
+	}
+	const std::vector<Texture>& chain = wallMipChains[id];
+	//the world width one pixel covers at this depth, in texels of the full-size texture
+	int level = TextureManager::getMipLevelIndex(depth / screenDist * chain[0].width, chain.size());
+	surfaceBatches[id * surfaceMipLevels + level].push_back(span);
 }
 
 void Canvas::drawBlood(Player player)
@@ -428,22 +698,11 @@ void Canvas::drawBlood(Player player)
 	DrawRectangleRec(screenTint, tint);
 }
 
-void Canvas::animate(Animated& animated, int index, Color color)
+void Canvas::animate(const Animated& animated, int index, Rectangle dest, Color color)
 {
-	Animation& current = animated.animations[index];
-	current.frameTimer += GetFrameTime();
-	if (current.frameTimer > GetFrameTime() * current.animationSpeed) {
-		current.frameTimer = 0;
-		if (!current.stop) {
-			current.nextFrame();
-		}
-	}
-	int frame = current.getCurrentFrame();
-	int frameWidth = current.texture.width / current.numFrames;
-	current.textureArea.width = frameWidth;
-	current.textureArea.x = frame * frameWidth;
-	DrawTexturePro(current.texture, current.textureArea, current.positionOnWindow, {0,0}, 0, color);
-	current.positionOnWindow.width = current.texture.width /current.numFrames;
+	const Animation* current = animated.animations[index];
+	int frame = animated.currentFrame % current->numFrames;
+	drawWorldTexture(current->texture, current->frames[frame], dest, color);
 }
 
 GameState Canvas::drawMenu()
@@ -509,17 +768,22 @@ GameState Canvas::drawPause()
 
 	ShowCursor();
 
-	Vector2 textPos = { windowWidth * 0.03, windowHeight * 0.1 };
-	DrawTextEx(titleFont, "PAUSED - Press p to resume", textPos, fontSize * 0.8, fontSize * 0.001, RED);
+	//the pause screen only changes with the window size
+	if (beginLayer(pauseLayer, { (double)windowWidth, (double)windowHeight })) {
+		Vector2 textPos = { windowWidth * 0.03, windowHeight * 0.1 };
+		DrawTextEx(titleFont, "PAUSED - Press p to resume", textPos, fontSize * 0.8, fontSize * 0.001, RED);
 
-	DrawRectangleRec(optionsButtonRect, DARKGRAY);
-	DrawText("Options", optionsButtonRect.x + buttonWidth * 0.1, optionsButtonRect.y + buttonHeight * 0.1, fontSize / 5, WHITE);
+		DrawRectangleRec(optionsButtonRect, DARKGRAY);
+		DrawText("Options", optionsButtonRect.x + buttonWidth * 0.1, optionsButtonRect.y + buttonHeight * 0.1, fontSize / 5, WHITE);
 
-	DrawRectangleRec(menuButtonRect, DARKGRAY);
-	DrawText("Main Menu", menuButtonRect.x + buttonWidth * 0.1, menuButtonRect.y + buttonHeight * 0.1, fontSize / 5, WHITE);
+		DrawRectangleRec(menuButtonRect, DARKGRAY);
+		DrawText("Main Menu", menuButtonRect.x + buttonWidth * 0.1, menuButtonRect.y + buttonHeight * 0.1, fontSize / 5, WHITE);
 
-	DrawRectangleRec(exitButtonRect, DARKGRAY);
-	DrawText("Exit game", exitButtonRect.x + buttonWidth * 0.1, exitButtonRect.y + buttonHeight * 0.1, fontSize / 5, WHITE);
+		DrawRectangleRec(exitButtonRect, DARKGRAY);
+		DrawText("Exit game", exitButtonRect.x + buttonWidth * 0.1, exitButtonRect.y + buttonHeight * 0.1, fontSize / 5, WHITE);
+		EndTextureMode();
+	}
+	drawLayer(pauseLayer);
 
 	Vector2 mousePosition = GetMousePosition();
 
@@ -553,6 +817,7 @@ GameState Canvas::drawOptions()
 	Rectangle sensibilityButtonRect;
 	Rectangle soundButtonRect;
 	Rectangle brightnessButtonRect;
+	Rectangle rendererButtonRect;
 	std::string titleText = "Options - press p to go back";
 	int titleFontSize = fontSize * 0.8;
 	int titleTextPosX = windowWidth * 0.03;
@@ -566,74 +831,92 @@ GameState Canvas::drawOptions()
 	Rectangle minusSound;
 	Rectangle minusDarkness;
 
-	DrawTextEx(titleFont, titleText.c_str(), { (float)titleTextPosX, (float)titleTextPosY }, titleFontSize, 2, GREEN);
-
 	sensibilityButtonRect = { (float)buttonX, float(buttonY), (float)buttonWidth, (float)buttonHeight};
-	DrawRectangleRec(sensibilityButtonRect, WHITE);
-	double sensibility = Player::getInstance()->getSensibility();
-	std::string str("Sensibility: ");
-	str.append(std::to_string(sensibility));
-	str.erase ( str.find_last_not_of('0') + 1, std::string::npos );
-	str.erase ( str.find_last_not_of('.') + 1, std::string::npos );
-	DrawText(str.c_str(), sensibilityButtonRect.x + buttonWidth * 0.1, sensibilityButtonRect.y + buttonHeight * 0.1, fontSize / 5, BLACK);
-
 	brightnessButtonRect = { float(buttonX), float(buttonY + buttonHeight + buttonOffset), (float)buttonWidth, (float)buttonHeight};
-	DrawRectangleRec(brightnessButtonRect, WHITE);
-	str = std::string("Darkness: ");
-	str.append(std::to_string(darkness * 10000));
-	str.erase ( str.find_last_not_of('0') + 1, std::string::npos );
-	str.erase ( str.find_last_not_of('.') + 1, std::string::npos );
-	DrawText(str.c_str(), brightnessButtonRect.x + buttonWidth * 0.1, brightnessButtonRect.y + buttonHeight * 0.1, fontSize / 5, BLACK);
-
-	str = std::string("Volume: ");
-	str.append(std::to_string(GetMasterVolume()));
-	str.erase ( str.find_last_not_of('0') + 1, std::string::npos );
-	str.erase ( str.find_last_not_of('.') + 1, std::string::npos );
 	soundButtonRect = { float(buttonX), float(buttonY + (buttonHeight + buttonOffset) * 2), (float)buttonWidth, (float)buttonHeight};
-	DrawRectangleRec(soundButtonRect, WHITE);
-	DrawText(str.c_str(), soundButtonRect.x + buttonWidth * 0.1, soundButtonRect.y + buttonHeight * 0.1, fontSize / 5, BLACK);
+	rendererButtonRect = { float(buttonX), float(buttonY + (buttonHeight + buttonOffset) * 3), (float)buttonWidth, (float)buttonHeight};
 
 	plusSensibility.x = sensibilityButtonRect.x + sensibilityButtonRect.width + buttonOffset;
 	plusSensibility.y = sensibilityButtonRect.y;
 	plusSensibility.width = squareSide;
 	plusSensibility.height = squareSide;
-	DrawRectangleRec(plusSensibility, LIGHTGRAY);
-	DrawText("+", plusSensibility.x * 1.04, plusSensibility.y, fontSize / 2, WHITE);
 
 	minusSensibility.x = plusSensibility.x + plusSensibility.width + buttonOffset;
 	minusSensibility.y = plusSensibility.y;
 	minusSensibility.width = squareSide;
 	minusSensibility.height = squareSide;
-	DrawRectangleRec(minusSensibility, LIGHTGRAY);
-	DrawText("-", minusSensibility.x * 1.04, minusSensibility.y, fontSize / 2, WHITE);
 
 	plusDarkness.x = brightnessButtonRect.x + brightnessButtonRect.width + buttonOffset;
 	plusDarkness.y = brightnessButtonRect.y;
 	plusDarkness.width = squareSide;
 	plusDarkness.height = squareSide;
-	DrawRectangleRec(plusDarkness, LIGHTGRAY);
-	DrawText("+", plusDarkness.x * 1.04, plusDarkness.y, fontSize / 2, WHITE);
 
 	minusDarkness.x = plusDarkness.x + plusDarkness.width + buttonOffset;
 	minusDarkness.y = plusDarkness.y;
 	minusDarkness.width = squareSide;
 	minusDarkness.height = squareSide;
-	DrawRectangleRec(minusDarkness, LIGHTGRAY);
-	DrawText("-", minusDarkness.x * 1.04, minusDarkness.y, fontSize / 2, WHITE);
 
 	plusSound.x = soundButtonRect.x + soundButtonRect.width + buttonOffset;
 	plusSound.y = soundButtonRect.y;
 	plusSound.width = squareSide;
 	plusSound.height = squareSide;
-	DrawRectangleRec(plusSound, LIGHTGRAY);
-	DrawText("+", plusSound.x * 1.04, plusSound.y, fontSize / 2, WHITE);
 
 	minusSound.x = plusSound.x + plusSound.width + buttonOffset;
 	minusSound.y = plusSound.y;
 	minusSound.width = squareSide;
 	minusSound.height = squareSide;
-	DrawRectangleRec(minusSound, LIGHTGRAY);
-	DrawText("-", minusSound.x * 1.04, minusSound.y, fontSize / 2, WHITE);
+
+	//redraw the screen only when one of the displayed values changes
+	double sensibility = Player::getInstance()->getSensibility();
+	LayerKey optionsKey = { (double)windowWidth, (double)windowHeight, sensibility, darkness, GetMasterVolume(), (double)renderBackend };
+	if (beginLayer(optionsLayer, optionsKey)) {
+		DrawTextEx(titleFont, titleText.c_str(), { (float)titleTextPosX, (float)titleTextPosY }, titleFontSize, 2, GREEN);
+
+		DrawRectangleRec(sensibilityButtonRect, WHITE);
+		std::string str("Sensibility: ");
+		str.append(std::to_string(sensibility));
+		str.erase ( str.find_last_not_of('0') + 1, std::string::npos );
+		str.erase ( str.find_last_not_of('.') + 1, std::string::npos );
+		DrawText(str.c_str(), sensibilityButtonRect.x + buttonWidth * 0.1, sensibilityButtonRect.y + buttonHeight * 0.1, fontSize / 5, BLACK);
+
+		DrawRectangleRec(brightnessButtonRect, WHITE);
+		str = std::string("Darkness: ");
+		str.append(std::to_string(darkness * 10000));
+		str.erase ( str.find_last_not_of('0') + 1, std::string::npos );
+		str.erase ( str.find_last_not_of('.') + 1, std::string::npos );
+		DrawText(str.c_str(), brightnessButtonRect.x + buttonWidth * 0.1, brightnessButtonRect.y + buttonHeight * 0.1, fontSize / 5, BLACK);
+
+		str = std::string("Volume: ");
+		str.append(std::to_string(GetMasterVolume()));
+		str.erase ( str.find_last_not_of('0') + 1, std::string::npos );
+		str.erase ( str.find_last_not_of('.') + 1, std::string::npos );
+		DrawRectangleRec(soundButtonRect, WHITE);
+		DrawText(str.c_str(), soundButtonRect.x + buttonWidth * 0.1, soundButtonRect.y + buttonHeight * 0.1, fontSize / 5, BLACK);
+
+		str = renderBackend == cpuRendering ? "Renderer: CPU" : "Renderer: GPU";
+		DrawRectangleRec(rendererButtonRect, WHITE);
+		DrawText(str.c_str(), rendererButtonRect.x + buttonWidth * 0.1, rendererButtonRect.y + buttonHeight * 0.1, fontSize / 5, BLACK);
+
+		DrawRectangleRec(plusSensibility, LIGHTGRAY);
+		DrawText("+", plusSensibility.x * 1.04, plusSensibility.y, fontSize / 2, WHITE);
+
+		DrawRectangleRec(minusSensibility, LIGHTGRAY);
+		DrawText("-", minusSensibility.x * 1.04, minusSensibility.y, fontSize / 2, WHITE);
+
+		DrawRectangleRec(plusDarkness, LIGHTGRAY);
+		DrawText("+", plusDarkness.x * 1.04, plusDarkness.y, fontSize / 2, WHITE);
+
+		DrawRectangleRec(minusDarkness, LIGHTGRAY);
+		DrawText("-", minusDarkness.x * 1.04, minusDarkness.y, fontSize / 2, WHITE);
+
+		DrawRectangleRec(plusSound, LIGHTGRAY);
+		DrawText("+", plusSound.x * 1.04, plusSound.y, fontSize / 2, WHITE);
+
+		DrawRectangleRec(minusSound, LIGHTGRAY);
+		DrawText("-", minusSound.x * 1.04, minusSound.y, fontSize / 2, WHITE);
+		EndTextureMode();
+	}
+	drawLayer(optionsLayer);
 
 	Vector2 mousePos = GetMousePosition();
 
@@ -679,6 +962,10 @@ GameState Canvas::drawOptions()
 		}
 	}
 
+	if (CheckCollisionPointRec(mousePos, rendererButtonRect) && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+		renderBackend = renderBackend == cpuRendering ? gpuRendering : cpuRendering;
+	}
+
 	return state;
 }
 
@@ -689,6 +976,10 @@ void Canvas::drawTransitionScreen()
 	int fontSize = windowHeight * 0.3;
 	int currentLevel = Map::getInstance()->getCurrentIndex();
 	int levelCount = Map::getInstance()->getMapCount();
+	if (!beginLayer(transitionLayer, { (double)windowWidth, (double)windowHeight, (double)currentLevel, (double)levelCount })) {
+		drawLayer(transitionLayer);
+		return;
+	}
 	if (currentLevel + 1 < levelCount) {
 		std::string finishedText("finished level " + std::to_string(currentLevel + 1));
 		std::string pressEnterText("Press enter");
@@ -701,5 +992,32 @@ void Canvas::drawTransitionScreen()
 		DrawTextEx(titleFont, finishedText.c_str(), { (float)textPosX, (float)textPosY }, fontSize, 0.1, RED);
 		DrawTextEx(titleFont, pressEnterText.c_str(), { (float)textPosX, (float)textPosY * 5 }, fontSize, 0.1, GRAY);
 	}
+	EndTextureMode();
+	drawLayer(transitionLayer);
+}
+
+bool Canvas::beginLayer(ScreenLayer& layer, const LayerKey& key)
+{
+	int width = GetScreenWidth();
+	int height = GetScreenHeight();
+	if (layer.target.id != 0 && layer.key == key && layer.target.texture.width == width && layer.target.texture.height == height) {
+		return false;
+	}
+	if (layer.target.id == 0 || layer.target.texture.width != width || layer.target.texture.height != height) {
+		if (layer.target.id != 0) {
+			UnloadRenderTexture(layer.target);
+		}
+		layer.target = LoadRenderTexture(width, height);
+	}
+	layer.key = key;
+	BeginTextureMode(layer.target);
+	ClearBackground(BLANK);
+	return true;
 }
 
+void Canvas::drawLayer(const ScreenLayer& layer)
+{
+	//render textures are stored upside down
+	Rectangle source = { 0, 0, (float)layer.target.texture.width, (float)-layer.target.texture.height };
+	DrawTextureRec(layer.target.texture, source, { 0, 0 }, WHITE);
+}
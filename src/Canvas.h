@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <array>
 #include <raylib.h>
 #include "TextureManager.h"
 #include "Point2D.h"
@@ -10,6 +11,51 @@
 #include "ItemManager.h"
 #include "Animated.h"
 #include "EnemyManager.h"
+#include "SoftwareRenderer.h"
+#include "LightMap.h"
+#include "SpriteBuffer.h"
+#include "RenderSnapshot.h"
+#define SPRITE_CULL_RADIUS 1.0
+#define TARGET_FPS 60
+#define RESOLUTION_SAMPLE_FRAMES 30
+#define MIN_RESOLUTION_SCALE 0.4
+#define RESOLUTION_SCALE_STEP 0.1
+#define LAYER_KEY_SIZE 6
+#define SURFACE_STRIP_RAYS 32
+#define SURFACE_MAX_DEPTH (GRID_SIZE * 1.5)
+
+typedef std::array<double, LAYER_KEY_SIZE> LayerKey; ///< Valores de los que depende una capa; los que sobran quedan en 0.
+
+/**
+ * @struct ScreenLayer
+ * @brief Capa de pantalla dibujada una vez en una textura y reutilizada mientras no cambie.
+ *
+ * Se usa para el HUD y las pantallas de pausa, opciones y transición, cuyo contenido
+ * solo depende de unos pocos valores (la clave).
+ */
+struct ScreenLayer {
+    RenderTexture target;    ///< Textura con el contenido de la capa.
+    LayerKey key;            ///< Valores con los que se dibujó la capa por última vez.
+};
+
+/**
+ * @struct SurfaceSpan
+ * @brief Tramo de una fila de suelo o techo que cae dentro de una sola celda.
+ *
+ * Se dibuja como un quad de un píxel de alto cuyas coordenadas de textura van de
+ * (`u0`, `v0`) a (`u1`, `v1`) dentro de la celda.
+ */
+struct SurfaceSpan {
+    float x0;             ///< Borde izquierdo en la vista.
+    float x1;             ///< Borde derecho en la vista.
+    float y;              ///< Fila de la vista.
+    float u0;             ///< Coordenada u de la textura en `x0`.
+    float v0;             ///< Coordenada v de la textura en `x0`.
+    float u1;             ///< Coordenada u de la textura en `x1`.
+    float v1;             ///< Coordenada v de la textura en `x1`.
+    unsigned char light0; ///< Brillo en `x0`.
+    unsigned char light1; ///< Brillo en `x1`.
+};
 
 /**
  * @class Canvas
@@ -32,15 +78,14 @@ public:
      *
      * Este método dibuja el mapa, el jugador, los objetos interactivos, los enemigos
      * y los elementos de la interfaz, dependiendo del estado actual del juego.
+     * El mundo se dibuja desde una instantánea, nunca desde los objetos que la simulación
+     * está modificando en ese momento.
      *
-     * @param map Referencia al mapa actual del juego.
-     * @param player Referencia al jugador.
-     * @param objManager Referencia al gestor de objetos (ítems).
-     * @param enemyManager Referencia al gestor de enemigos.
+     * @param snapshot Última instantánea publicada por la simulación.
      * @param state Estado actual del juego.
      * @return El estado siguiente del juego tras completar el ciclo de renderizado.
      */
-    GameState draw(const Map& map, Player& player, ItemManager& objManager, EnemyManager& enemyManager, GameState state);
+    GameState draw(RenderSnapshot& snapshot, GameState state);
 
     /**
      * @brief Constructor por defecto.
@@ -59,6 +104,7 @@ public:
 
 private:
     TextureManager* textureManager; ///< Administrador de texturas.
+    LightMap* lightMap;             ///< Luz estática de las lámparas del nivel.
     Font titleFont;                 ///< Fuente utilizada para títulos y textos.
     int screenWidth;                ///< Ancho de la pantalla.
     int screenHeight;               ///< Alto de la pantalla.
@@ -66,9 +112,30 @@ private:
     int windowHeight;               ///< Alto de la ventana.
     int halfWindowWidth;            ///< Mitad del ancho de la ventana.
     int halfWindowHeight;           ///< Mitad del alto de la ventana.
+    int viewWidth;                  ///< Ancho interno de la vista 3D.
+    int viewHeight;                 ///< Alto interno de la vista 3D.
+    int halfViewWidth;              ///< Mitad del ancho interno de la vista 3D.
+    int halfViewHeight;             ///< Mitad del alto interno de la vista 3D.
+    double resolutionScale;         ///< Fracción de la resolución de la ventana usada por la vista 3D.
+    double frameTimeSum;            ///< Suma de los tiempos de cuadro medidos desde el último ajuste.
+    double workTimeSum;             ///< Suma del tiempo de dibujo de la vista 3D desde el último ajuste.
+    int sampledFrames;              ///< Cuadros medidos desde el último ajuste de resolución.
+    RenderTexture viewTarget;       ///< Textura donde se dibuja la vista 3D antes de escalarla a la ventana.
+    ScreenLayer hudLayer;           ///< HUD en caché.
+    ScreenLayer pauseLayer;         ///< Pantalla de pausa en caché.
+    ScreenLayer optionsLayer;       ///< Pantalla de opciones en caché.
+    ScreenLayer transitionLayer;    ///< Pantalla de transición en caché.
     double backgroundOffset;        ///< Offset para el fondo animado.
     double darkness;                ///< Nivel de oscuridad aplicado en el renderizado.
     std::vector<Drawable*> drawQueue; ///< Cola de objetos a dibujar.
+    SpriteBuffer spriteBuffer;      ///< Sprites del cuadro actual pendientes de proyectar.
+    RenderBackend renderBackend;    ///< Backend usado para la vista 3D.
+    SoftwareRenderer softwareRenderer; ///< Rasterizador por CPU usado cuando el backend es `cpuRendering`.
+    std::vector<std::vector<Texture>> wallMipChains; ///< Cadenas de mipmaps de pared indexadas por `WallType`.
+    std::vector<std::vector<SurfaceSpan>> surfaceBatches; ///< Tramos de suelo y techo del cuadro, agrupados por textura y mipmap.
+    int surfaceMipLevels;           ///< Niveles por textura en `surfaceBatches`.
+    std::vector<Point2D> stripDirections; ///< Dirección por unidad de profundidad en cada borde de franja.
+    std::vector<double> surfaceCrossings; ///< Puntos donde una franja cruza bordes de celda.
 
     // Raycasting
     RayCaster rayCaster; ///< Sistema de raycasting para el renderizado 3D.
@@ -76,16 +143,103 @@ private:
     double halfFOV;      ///< Mitad del campo de visión.
     double screenDist;   ///< Distancia virtual desde el jugador a la pantalla.
     double scale;        ///< Escalado de los elementos renderizados.
+    double viewCos;      ///< Coseno del ángulo del jugador en el cuadro actual.
+    double viewSin;      ///< Seno del ángulo del jugador en el cuadro actual.
 
     /**
      * @brief Renderiza la escena 3D basada en raycasting.
      *
+     * @param snapshot Instantánea con el jugador, el mapa y los sprites del cuadro.
+     */
+    void draw3D(RenderSnapshot& snapshot);
+
+    /**
+     * @brief Cambia la resolución interna de la vista 3D.
+     *
+     * Recalcula el número de rayos, la distancia a la pantalla y las dimensiones de la vista,
+     * y si la ventana ya existe vuelve a crear la textura de destino y el framebuffer por software.
+     *
+     * @param resolutionScale Fracción de la resolución de la ventana, entre `MIN_RESOLUTION_SCALE` y 1.
+     */
+    void setResolutionScale(double resolutionScale);
+
+    /**
+     * @brief Ajusta la resolución interna para mantener el tiempo de cuadro objetivo.
+     *
+     * Acumula mediciones durante `RESOLUTION_SAMPLE_FRAMES` cuadros y luego baja la resolución
+     * si el promedio supera el presupuesto de `TARGET_FPS`, o la sube si sobra margen.
+     *
+     * @param workTime Tiempo que tomó dibujar la vista 3D y el HUD en este cuadro, en segundos.
+     */
+    void updateResolutionScale(double workTime);
+
+    /**
+     * @brief Calcula la distancia a partir de la cual la niebla oculta por completo un objeto.
+     *
+     * Es la distancia en la que el factor de oscuridad deja el color por debajo de 1.
+     *
+     * @return Distancia de la niebla en unidades del mundo, o un valor negativo si no hay oscuridad.
+     */
+    double getFogDistance();
+
+    /**
+     * @brief Determina de forma barata si un sprite puede ser visible antes de proyectarlo.
+     *
+     * Descarta los sprites fuera del cono de visión, más allá de la niebla o
+     * completamente tapados por las paredes de los rayos recién lanzados.
+     *
+     * @param position Posición del sprite en el mundo.
+     * @param rays Rayos lanzados en este cuadro, ordenados por columna.
+     * @param player Referencia al jugador.
+     * @param fogDistance Distancia máxima visible (ver `getFogDistance`).
+     * @return true si el sprite debe agregarse a la cola de dibujo.
+     */
+    bool isSpriteVisible(Point2D position, const std::vector<RayCastResult>& rays, const Player& player, double fogDistance);
+
+    /**
+     * @brief Prepara el framebuffer del renderizador por software para un nuevo cuadro.
+     *
+     * La primera vez reserva el framebuffer (un píxel por rayo) y decodifica las texturas.
+     * También configura la cámara para proyectar el suelo y el techo del mapa.
+     *
      * @param player Referencia al jugador.
      * @param map Referencia al mapa actual.
-     * @param objManager Referencia al gestor de objetos.
-     * @param enemyManager Referencia al gestor de enemigos.
+     * @param firstRayAngle Ángulo del rayo de la primera columna.
      */
-    void draw3D(const Player& player, const Map& map, ItemManager& objManager, EnemyManager& enemyManager);
+    void beginSoftwareFrame(const Player& player, const Map& map, double firstRayAngle);
+
+    /**
+     * @brief Obtiene la textura asociada a un tipo de pared.
+     *
+     * @param wall Tipo de pared (también usado como identificador de textura de suelo y techo).
+     * @return La textura correspondiente, o la textura de error si no existe.
+     */
+    Texture getWallTexture(WallType wall);
+
+    /**
+     * @brief Calcula el color de iluminación de un punto del mundo.
+     *
+     * Combina la atenuación por oscuridad según la profundidad con la luz horneada
+     * de las lámparas en ese punto.
+     *
+     * @param depth Profundidad del punto respecto al jugador.
+     * @param position Posición del punto en el mundo.
+     * @return Color gris con el que se tiñe la textura.
+     */
+    Color getLitColor(double depth, Point2D position);
+
+    /**
+     * @brief Dibuja una textura del mundo 3D con el backend activo.
+     *
+     * Con un cuadro de software abierto el dibujo se rasteriza en el framebuffer;
+     * en caso contrario se envía a la GPU con `DrawTexturePro`.
+     *
+     * @param texture Textura a dibujar.
+     * @param source Área de la textura.
+     * @param dest Área de destino en píxeles de la ventana.
+     * @param tint Color aplicado a la textura.
+     */
+    void drawWorldTexture(Texture texture, Rectangle source, Rectangle dest, Color tint);
 
     /**
      * @brief Renderiza una columna específica como parte del renderizado 3D.
@@ -104,9 +258,52 @@ private:
     /**
      * @brief Renderiza el fondo animado del juego.
      *
+     * Con el backend por GPU también proyecta el suelo y el techo texturizados del mapa.
+     *
      * @param player Referencia al jugador para ajustar el fondo según su posición.
+     * @param map Mapa con las texturas de suelo y techo de cada celda.
+     */
+    void drawBackground(Player player, const Map& map);
+
+    /**
+     * @brief Proyecta el suelo y el techo del mapa con la GPU, una tira por fila de la vista.
+     *
+     * Cada fila por debajo del horizonte ve el suelo a una sola profundidad, y la fila
+     * simétrica por encima ve el techo a la misma. La fila se recorre en franjas de
+     * `SURFACE_STRIP_RAYS` rayos con la dirección exacta en cada borde, y cada franja se
+     * corta donde cruza un borde de celda. Los tramos se agrupan por textura y mipmap, así
+     * que se dibujan con un cambio de textura por grupo. El brillo usa la misma tabla de
+     * profundidad que las paredes más la luz de las lámparas.
+     *
+     * @param player Jugador desde el que se mira.
+     * @param map Mapa con las texturas de suelo y techo de cada celda.
+     */
+    void castSurfaces(const Player& player, const Map& map);
+
+    /**
+     * @brief Corta una franja de una fila en tramos de una celda y los agrega a su grupo.
+     *
+     * @param start Punto del mundo en el borde izquierdo de la franja.
+     * @param end Punto del mundo en el borde derecho de la franja.
+     * @param x0 Borde izquierdo de la franja en la vista.
+     * @param x1 Borde derecho de la franja en la vista.
+     * @param row Distancia de la fila al horizonte, en filas.
+     * @param depth Profundidad de la fila.
+     * @param shade Brillo de la fila según la profundidad.
+     * @param floorGrid Texturas de suelo por celda.
+     * @param ceilingGrid Texturas de techo por celda.
+     */
+    void addSurfaceSpans(Point2D start, Point2D end, float x0, float x1, int row, double depth, int shade,
+                         WallType** floorGrid, WallType** ceilingGrid);
+
+    /**
+     * @brief Agrega un tramo al grupo de su textura, eligiendo el mipmap por la profundidad.
+     *
+     * @param id Textura de la celda; `none` no se dibuja.
+     * @param span Tramo a agregar.
+     * @param depth Profundidad de la fila.
      */
-    void drawBackground(Player player);
+    void addSurfaceSpan(WallType id, const SurfaceSpan& span, double depth);
 
     /**
      * @brief Renderiza el efecto de sangre en la pantalla (daño recibido).
@@ -116,38 +313,72 @@ private:
     void drawBlood(Player player);
 
     /**
-     * @brief Gestiona y renderiza la animación de un sprite.
+     * @brief Renderiza el cuadro actual de la animación de un sprite.
+     *
+     * Solo lee el cuadro; la simulación es la que avanza las animaciones.
      *
      * @param animated Referencia al objeto animado.
      * @param index �ndice de la animación a reproducir.
+     * @param dest Área de destino en la ventana o en la vista 3D.
      * @param color Color aplicado a la animación.
      */
-    void animate(Animated& animated, int index, Color color);
+    void animate(const Animated& animated, int index, Rectangle dest, Color color);
 
     /**
-     * @brief Renderiza un sprite animado en relación con la posición del jugador.
+     * @brief Renderiza un sprite animado ya proyectado.
+     *
+     * Usa la posición en pantalla y la profundidad calculadas por `SpriteBuffer::project`.
      *
      * @param sprite Referencia al sprite animado.
-     * @param player Referencia al jugador.
      */
-    void drawAnimatedSprite(Animated& sprite, Player player);
+    void drawAnimatedSprite(Animated& sprite);
 
     /**
      * @brief Renderiza la interfaz HUD.
      *
      * Muestra información como la salud, munición y otros elementos relevantes.
+     * El HUD se compone en `hudLayer` y solo se vuelve a dibujar cuando cambian la munición,
+     * la salud, el estado de recarga o el tamaño de la ventana.
      *
      * @param player Referencia al jugador.
      */
     void drawHUD(Player& player);
 
     /**
-     * @brief Renderiza un sprite estático en la pantalla.
+     * @brief Dibuja el contenido del HUD en la capa activa.
      *
-     * @param sprite Sprite a dibujar.
      * @param player Referencia al jugador.
      */
-    void drawStaticSprite(Drawable sprite, Player player);
+    void drawHUDContents(Player& player);
+
+    /**
+     * @brief Prepara una capa en caché para volver a dibujarla si su clave cambió.
+     *
+     * Si la clave y el tamaño de la ventana coinciden con los del último dibujo devuelve false.
+     * En caso contrario (re)crea la textura, la limpia y deja activo `BeginTextureMode`;
+     * quien llama dibuja el contenido y termina con `EndTextureMode`.
+     *
+     * @param layer Capa a preparar.
+     * @param key Valores de los que depende el contenido de la capa.
+     * @return true si hay que volver a dibujar el contenido.
+     */
+    bool beginLayer(ScreenLayer& layer, const LayerKey& key);
+
+    /**
+     * @brief Dibuja una capa en caché sobre toda la ventana.
+     *
+     * @param layer Capa a dibujar.
+     */
+    void drawLayer(const ScreenLayer& layer);
+
+    /**
+     * @brief Renderiza un sprite estático ya proyectado.
+     *
+     * Usa la posición en pantalla y la profundidad calculadas por `SpriteBuffer::project`.
+     *
+     * @param sprite Sprite a dibujar.
+     */
+    void drawStaticSprite(Drawable& sprite);
 
     /**
      * @brief Renderiza el menú principal.
@@ -2,7 +2,7 @@
 #include "Drawable.h"
 #include "Player.h"
 
-double Drawable::getDistanceFromPlayer(Point2D position, Player player)
+double Drawable::getDistanceFromPlayer(Point2D position, const Player& player)
 {
     Point2D playerDistance;
 	playerDistance.x = position.x - player.position.x;
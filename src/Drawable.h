@@ -59,14 +59,6 @@ public:
      */
     Point2D position;
 
-    /**
-     * @brief Indica si el objeto está en el centro de la pantalla.
-     *
-     * Este atributo se utiliza para verificar si el objeto se encuentra
-     * en el campo de visión principal del jugador.
-     */
-    bool isOnScreenCenter;
-
     /**
      * @brief Textura asociada al objeto.
      */
@@ -82,7 +74,7 @@ public:
      * @param player Referencia al jugador.
      * @return Distancia en unidades del mundo.
      */
-    double getDistanceFromPlayer(Point2D position, Player player);
+    double getDistanceFromPlayer(Point2D position, const Player& player);
 
     /**
      * @brief Destructor virtual para poder usar dynamic_cast<>().
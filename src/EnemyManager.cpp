@@ -2,171 +2,559 @@
 #include "FileReader.h"
 #include "RayCaster.h"
 #include <iostream>
-#include "SoundManager.h"
+#include "AudioSystem.h"
 #include "ItemManager.h"
 #include "Lamp.h"
-#include "RangedEnemy.h"
-#include "MeleeEnemy.h"
 #include "TextureManager.h"
+#include "AnimationSystem.h"
+#include "GameClock.h"
+#include "JobSystem.h"
+#include <cmath>
+#include <algorithm>
 
-std::vector<Enemy*>* EnemyManager::getEnemyList()
+EnemyStore* EnemyManager::getEnemies()
 {
-    return &enemyList;
+	return &enemies;
+}
+
+ProjectilePool* EnemyManager::getProjectiles()
+{
+	return &projectiles;
 }
 
 void EnemyManager::initEnemies()
 {
 	clearEnemies();
+	Map* map = Map::getInstance();
+	spawner.load(map->getCurrentIndex());
+	if (spawner.isStress()) {
+		//the stress scenario replaces the level's enemies with a horde spread over every reachable cell
+		flowField.update(*map, Player::getInstance()->position);
+		spawner.spawnStress(flowField, enemies);
+		return;
+	}
 	ItemManager* itMgr = ItemManager::getInstance();
-	TextureManager* texMgr = TextureManager::getInstance();
 	auto itemList = itMgr->getCurrentItemList();
 	for (auto item : *itemList) {
 		Lamp* lampPtr = dynamic_cast<Lamp*>(item);
 		if (lampPtr) {
 			EnemyType type;
-			if (Map::getInstance()->getCurrentIndex() < 2) {
+			if (map->getCurrentIndex() < 2) {
 				type = EnemyType(itMgr->getCurrentLevel() % 2 + 1);
 			}
 			else {
-				type = EnemyType(rand() % 2 + 1);
-			}
-			Point2D pos = lampPtr->position;
-			switch (type) {
-                case melee:
-                {
-                    MeleeEnemy* enemy = new MeleeEnemy(pos);
-                    enemy->sprite = new Animated();
-                    enemy->sprite->tex = texMgr->getTexture("");
-                    enemy->sprite->animationIndex = 0;
-                    enemy->sprite->scale = 0.9;
-                    enemy->sprite->shift = 0.1;
-                    enemy->sprite->position = enemy->position;
-
-                    Animation walk = {};
-                    walk.texture = texMgr->getTexture("sprites/animated/demon_walk.png");
-                    walk.numFrames = 4;
-                    walk.animationSpeed = 7.0;
-
-                    Animation hurt = {};
-                    hurt.texture = texMgr->getTexture("sprites/animated/demon_hurt.png");
-                    hurt.numFrames = 5;
-                    hurt.animationSpeed = 5.0;
-
-                    Animation death = {};
-                    death.texture = texMgr->getTexture("sprites/animated/demon_death.png");
-                    death.numFrames = 7;
-                    death.animationSpeed = 3.5;
-
-                    enemy->sprite->animations.push_back(walk);
-                    enemy->sprite->animations.push_back(hurt);
-                    enemy->sprite->animations.push_back(death);
-                    enemyList.push_back(enemy);
-                    break;
-                }
-				case range:
-				{
-					RangedEnemy* enemy = new RangedEnemy(pos);
-					enemy->sprite = new Animated();
-					enemy->sprite->tex = texMgr->getTexture("");
-					enemy->sprite->animationIndex = 0;
-					enemy->sprite->scale = 1;
-					enemy->sprite->shift = 0;
-					enemy->sprite->position = enemy->position;
-
-					Animation walk = {};
-					walk.texture = texMgr->getTexture("sprites/animated/zombie_walk.png");
-					walk.numFrames = 4;
-					walk.animationSpeed = 9.0;
-					enemy->sprite->animations.push_back(walk);
-
-					Animation hurt = {};
-					hurt.texture = texMgr->getTexture("sprites/animated/zombie_hurt.png");
-					hurt.numFrames = 4;
-					hurt.animationSpeed = 8.0;
-					enemy->sprite->animations.push_back(hurt);
-
-					Animation death = {};
-					death.texture = texMgr->getTexture("sprites/animated/zombie_death.png");
-					death.numFrames = 7;
-					death.animationSpeed = 9.0;
-					enemy->sprite->animations.push_back(death);
-					enemyList.push_back(enemy);
-				}
+				type = spawner.pickType(1, 1);
 			}
+			enemies.spawn(type, lampPtr->position);
 		}
 	}
 }
 
 void EnemyManager::clearEnemies()
 {
-	for (auto& enemy : enemyList) {
-		delete enemy;
-	}
-    enemyList.clear();
+	enemies.clear();
+	projectiles.clear();
 }
 
-void EnemyManager::runEnemyBehaviour(Player& player, Map map)
+void EnemyManager::runEnemyBehaviour(Player& player, Map& map)
 {
-	RayCaster raycaster;
-	RayCastResult ray;
-	for (auto enemy : enemyList) {
-		enemy->act(map);
-		damageEnemy(enemy, player, map);
-		setEnemyState(enemy);
+	double deltaTime = GameClock::getInstance()->getDeltaTime();
+	JobSystem* jobs = JobSystem::getInstance();
+	spawner.update(deltaTime, map, player.position, enemies);
+	scheduleEnemies(player, map, deltaTime);
+
+	//chunks of enemies move and attack in parallel, every side effect waits in the chunk's buffer
+	int chunks = (enemies.size() + ENEMY_JOB_CHUNK - 1) / ENEMY_JOB_CHUNK;
+	if ((int)commandBuffers.size() < chunks) {
+		commandBuffers.resize(chunks);
+		neighbourBuffers.resize(chunks);
 	}
+	jobs->parallelFor(enemies.size(), ENEMY_JOB_CHUNK, [&](int /*chunk*/, int begin, int end) {
+		RayCaster rayCaster;
+		for (int i = begin; i < end; i++) {
+			decideEnemy(i, player, map, rayCaster);
+		}
+	});
+	//steering reads the neighbours' positions, so nobody moves until every velocity is known
+	jobs->parallelFor(enemies.size(), ENEMY_JOB_CHUNK, [&](int chunk, int begin, int end) {
+		for (int i = begin; i < end; i++) {
+			steerEnemy(i, player, neighbourBuffers[chunk]);
+		}
+	});
+	jobs->parallelFor(enemies.size(), ENEMY_JOB_CHUNK, [&](int chunk, int begin, int end) {
+		for (int i = begin; i < end; i++) {
+			moveEnemy(i, map, deltaTime);
+			attackPlayer(i, player, deltaTime, commandBuffers[chunk]);
+		}
+	});
+	for (int i = 0; i < enemies.size(); i++) {
+		enemies.grid.update(enemies.getSlot(i), enemies.position[i]);
+	}
+	executeCommands(player, chunks);
+
+	projectiles.update(player, map, deltaTime);
+	damageEnemies(player, map);
+
+	jobs->parallelFor(enemies.size(), ENEMY_JOB_CHUNK, [&](int chunk, int begin, int end) {
+		for (int i = begin; i < end; i++) {
+			setEnemyState(i, commandBuffers[chunk]);
+		}
+	});
+	executeCommands(player, chunks);
 	player.justShot = false;
 }
 
 bool EnemyManager::areEnemiesDead()
 {
-	for (auto& enemy : enemyList) {
-		if (enemy->isAlive()) {
+	//the level isn't over while waves are still coming
+	if (!spawner.isFinished()) {
+		return false;
+	}
+	for (int health : enemies.health) {
+		if (health > 0) {
 			return false;
 		}
 	}
 	return true;
 }
 
-void EnemyManager::damageEnemy(Enemy* enemy, Player player, Map map)
+void EnemyManager::setStressCount(int count)
 {
-	RayCaster raycaster;
-	RayCastResult ray;
-	bool wasWallShot;
-	bool canTakeDamage;
-	ray = raycaster.rayCast(player.angle, player.position, map);
-	wasWallShot = ray.depth < enemy->sprite->getDistanceFromPlayer(enemy->position, player);
-	canTakeDamage = player.justShot && !wasWallShot && enemy->isAlive() && enemy->sprite->isOnScreenCenter;
-	if (canTakeDamage){
-		int range = player.weapon->getRange();
-		int damage = player.weapon->getDamage() * (range - enemy->sprite->getDistanceFromPlayer(enemy->position, player))/range;
-		if (damage < 0) {
-			damage = 0;
+	spawner.setStressCount(count);
+}
+
+void EnemyManager::setSeed(unsigned int seed)
+{
+	spawner.setSeed(seed);
+}
+
+unsigned int EnemyManager::getSeed()
+{
+	return spawner.getSeed();
+}
+
+void EnemyManager::save(StateWriter& out)
+{
+	enemies.save(out);
+	projectiles.save(out);
+	spawner.save(out);
+	out.write<int32_t>(thinkCursor);
+}
+
+bool EnemyManager::load(StateReader& in)
+{
+	spawner.load(Map::getInstance()->getCurrentIndex());
+	int32_t cursor;
+	if (!enemies.load(in) || !projectiles.load(in) || !spawner.load(in) || !in.read(cursor)) {
+		return false;
+	}
+	thinkCursor = cursor;
+	return true;
+}
+
+EnemyManager::EnemyManager()
+{
+	thinkCursor = 0;
+}
+
+void EnemyManager::scheduleEnemies(const Player& player, Map& map, double deltaTime)
+{
+	//one field serves every enemy, it's only rebuilt when the player changes cell or a door toggles
+	if (flowField.update(map, player.position)) {
+		//a door may have opened a way to enemies that were shut away
+		for (int i = 0; i < enemies.size(); i++) {
+			if (enemies.sleeping[i] && flowField.getDistance(int(enemies.position[i].y), int(enemies.position[i].x)) >= 0) {
+				enemies.sleeping[i] = 0;
+			}
 		}
-		enemy->takeDamage(damage);
 	}
-	setEnemyState(enemy);
+	wakeEnemies(player.position, AI_WAKE_RADIUS);
+	if (player.justShot) {
+		wakeEnemies(player.position, AI_NOISE_RADIUS);
+	}
+
+	RayCaster rayCaster;
+	int count = enemies.size();
+	thinkNow.assign(count, 0);
+	int budget = AI_THINK_BUDGET;
+	int lastThought = -1;
+	for (int k = 0; k < count; k++) {
+		//start where the last tick's budget ran out so every distant enemy gets its turn
+		int i = (thinkCursor + k) % count;
+		//hurt enemies and ranged enemies about to shoot stand still
+		if (!enemies.isAlive(i) || enemies.hurt[i] || enemies.attacking[i] || enemies.sleeping[i]) {
+			continue;
+		}
+
+		//enemies that see the player, have a goal or are a few steps away think every tick
+		enemies.thinkTimer[i] += deltaTime;
+		int steps = flowField.getDistance(int(enemies.position[i].y), int(enemies.position[i].x));
+		bool onSight = enemies.playerDistance[i] < enemies.wallDistance[i];
+		bool urgent = onSight || enemies.hasGoal[i] || (steps >= 0 && steps <= AI_NEAR_STEPS);
+		if (enemies.hasGoal[i]) {
+			//the pathfinder's cache is shared, enemies with a goal think here instead of in the jobs
+			thinkEnemy(i, player, map, rayCaster);
+		}
+		else if (urgent) {
+			thinkNow[i] = 1;
+		}
+		else if (enemies.thinkTimer[i] >= AI_THINK_INTERVAL && budget > 0) {
+			thinkNow[i] = 1;
+			budget--;
+			lastThought = i;
+		}
+	}
+	if (lastThought >= 0 && budget == 0) {
+		thinkCursor = lastThought + 1;
+	}
 }
 
-void EnemyManager::setEnemyState(Enemy* enemy)
+void EnemyManager::decideEnemy(int index, const Player& player, Map& map, RayCaster& rayCaster)
 {
-	if (enemy->isAlive() && enemy->hurt) {
-		enemy->sprite->animationIndex = 1;
-		auto& anim = enemy->sprite->animations[enemy->sprite->animationIndex];
-		if (anim.isAnimationDone()) {
-			anim.resetAnimation();
-			enemy->hurt = false;
+	enemies.previousPosition[index] = enemies.position[index];
+	if (isEnemyActive(index) && thinkNow[index]) {
+		thinkEnemy(index, player, map, rayCaster);
+	}
+}
+
+bool EnemyManager::isEnemyActive(int index)
+{
+	return enemies.isAlive(index) && !enemies.hurt[index] && !enemies.attacking[index] && !enemies.sleeping[index];
+}
+
+void EnemyManager::thinkEnemy(int index, const Player& player, Map& map, RayCaster& rayCaster)
+{
+	enemies.thinkTimer[index] = 0;
+	enemies.moving[index] = 0;
+	Point2D position = enemies.position[index];
+	double dx = player.position.x - position.x;
+	double dy = player.position.y - position.y;
+	double angle = atan2(dy, dx);
+
+	RayCastResult ray = rayCaster.rayCast(angle, position, map);
+	double distanceFromPlayer = sqrt(dx * dx + dy * dy);
+	enemies.playerDistance[index] = distanceFromPlayer;
+	enemies.wallDistance[index] = ray.depth;
+
+	//walk straight at a player on sight, otherwise to the enemy's own goal or along the field
+	bool onSight = ray.depth > distanceFromPlayer;
+	Point2D waypoint;
+	if (onSight) {
+		enemies.hasGoal[index] = 0;
+	}
+	else if (enemies.hasGoal[index]) {
+		if (pathfinder.getWaypoint(map, position, enemies.goal[index], waypoint)) {
+			enemies.angle[index] = atan2(waypoint.y - position.y, waypoint.x - position.x);
+			enemies.moving[index] = 1;
 		}
+		else {
+			//arrived, or the goal can't be reached anymore
+			enemies.hasGoal[index] = 0;
+		}
+		return;
 	}
-	else {
-		if (!enemy->isAlive()) {
-			enemy->sprite->animationIndex = 2;
-			auto& deathAnimation = enemy->sprite->animations[enemy->sprite->animationIndex];
-			if (deathAnimation.isAnimationDone()) {
-				deathAnimation.stop = true;
-			}
+	else if (flowField.getWaypoint(position, waypoint)) {
+		angle = atan2(waypoint.y - position.y, waypoint.x - position.x);
+	}
+	enemies.angle[index] = angle;
+	if (!onSight && flowField.getDistance(int(position.y), int(position.x)) < 0) {
+		//no way to the player, sleep until a door, a noise or the player wakes it
+		enemies.sleeping[index] = 1;
+		return;
+	}
+	enemies.moving[index] = distanceFromPlayer > ARRIVAL_STOP_DISTANCE;
+}
+
+void EnemyManager::wakeEnemies(Point2D position, double radius)
+{
+	nearby.clear();
+	enemies.grid.queryRadius(position, radius, nearby);
+	for (int slot : nearby) {
+		int i = enemies.indexOfSlot(slot);
+		if (i >= 0) {
+			enemies.sleeping[i] = 0;
+		}
+	}
+}
+
+void EnemyManager::steerEnemy(int index, const Player& player, std::vector<int>& neighbours)
+{
+	Point2D& velocity = enemies.velocity[index];
+	velocity = { 0, 0 };
+	if (!isEnemyActive(index)) {
+		return;
+	}
+	Point2D position = enemies.position[index];
+	double speed = enemies.speed[index];
+
+	//between thoughts an enemy keeps walking the way it last decided, slowing down as it arrives
+	if (enemies.moving[index]) {
+		double factor = 1;
+		Point2D target;
+		bool arriving = true;
+		if (enemies.hasGoal[index]) {
+			target = enemies.goal[index];
+		}
+		else if (enemies.playerDistance[index] < enemies.wallDistance[index]) {
+			target = player.position;
 		}
 		else {
-			enemy->sprite->animationIndex = 0;
+			arriving = false;
+		}
+		if (arriving) {
+			double distance = hypot(target.x - position.x, target.y - position.y);
+			factor = std::clamp((distance - ARRIVAL_STOP_DISTANCE) / ARRIVAL_RADIUS, 0.0, 1.0);
 		}
+		velocity.x = cos(enemies.angle[index]) * speed * factor;
+		velocity.y = sin(enemies.angle[index]) * speed * factor;
+	}
+
+	//push away from living neighbours in range, capped at the first few the grid hands over in cell order
+	neighbours.clear();
+	enemies.grid.queryRadius(position, SEPARATION_RADIUS, neighbours);
+	Point2D push = { 0, 0 };
+	int counted = 0;
+	for (int slot : neighbours) {
+		int j = enemies.indexOfSlot(slot);
+		if (j < 0 || j == index || !enemies.isAlive(j)) {
+			continue;
+		}
+		double dx = position.x - enemies.position[j].x;
+		double dy = position.y - enemies.position[j].y;
+		double distance = sqrt(dx * dx + dy * dy);
+		if (distance >= SEPARATION_RADIUS) {
+			continue;
+		}
+		if (distance < 1e-6) {
+			//stacked on the exact same spot, each one picks its own way out
+			double angle = index * 2.399963;
+			dx = cos(angle);
+			dy = sin(angle);
+			distance = 1;
+		}
+		double weight = (SEPARATION_RADIUS - distance) / SEPARATION_RADIUS;
+		push.x += dx / distance * weight;
+		push.y += dy / distance * weight;
+		if (++counted == SEPARATION_MAX_NEIGHBOURS) {
+			break;
+		}
+	}
+	velocity.x += push.x * speed * SEPARATION_WEIGHT;
+	velocity.y += push.y * speed * SEPARATION_WEIGHT;
+
+	//an enemy can't be shoved faster than it walks
+	double length = sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
+	if (length > speed) {
+		velocity.x *= speed / length;
+		velocity.y *= speed / length;
+	}
+}
+
+void EnemyManager::moveEnemy(int index, Map& map, double deltaTime)
+{
+	Point2D& position = enemies.position[index];
+	Point2D d;
+	d.x = enemies.velocity[index].x * deltaTime;
+	d.y = enemies.velocity[index].y * deltaTime;
+	//each axis moves on its own, so an enemy pushed into a wall slides along it
+	if (map.isPositionEmpty(int(position.y + d.y), int(position.x))) {
+		position.y += d.y;
+	}
+	if (map.isPositionEmpty(int(position.y), int(position.x + d.x))) {
+		position.x += d.x;
+	}
+}
+
+void EnemyManager::attackPlayer(int index, const Player& player, double deltaTime, std::vector<EnemyCommand>& commands)
+{
+	if (!enemies.isAlive(index) || enemies.hurt[index]) {
+		return;
+	}
+	if (enemies.type[index] == melee) {
+		double dx = enemies.position[index].x - player.position.x;
+		double dy = enemies.position[index].y - player.position.y;
+		if (dx * dx + dy * dy <= MELEE_RANGE * MELEE_RANGE) {
+			commands.push_back({ damagePlayerCommand, index, 0, false, soundCount });
+		}
+		return;
+	}
+
+	//ranged enemies wind up for a tick, then shoot
+	if (enemies.attacking[index]) {
+		commands.push_back({ soundCommand, index, 0, false, zombieShootSound });
+		commands.push_back({ projectileCommand, index, 0, false, soundCount });
+		enemies.attacking[index] = 0;
+	}
+	else if (enemies.playerDistance[index] < enemies.wallDistance[index] && enemies.attackTimer[index] > RANGED_ATTACK_COOLDOWN) {
+		enemies.attacking[index] = 1;
+		enemies.attackTimer[index] = 0;
+	}
+	enemies.attackTimer[index] += deltaTime;
+}
+
+void EnemyManager::executeCommands(Player& player, int chunks)
+{
+	//buffers are applied in chunk order, so the outcome doesn't depend on which thread ran which chunk
+	AudioSystem* audio = AudioSystem::getInstance();
+	AnimationSystem* animations = AnimationSystem::getInstance();
+	for (int chunk = 0; chunk < chunks; chunk++) {
+		for (const EnemyCommand& command : commandBuffers[chunk]) {
+			int i = command.enemy;
+			switch (command.type) {
+				case damagePlayerCommand:
+					if (player.isAlive() && !player.hurt) {
+						audio->playIfIdle(demonAttackSound); //sonido de ataque
+						player.takeDamage(enemies.damage[i]);
+					}
+					break;
+				case soundCommand:
+					audio->playAt(command.sound, enemies.position[i]);
+					break;
+				case projectileCommand:
+					projectiles.spawn(enemies.position[i], enemies.angle[i], enemies.damage[i]);
+					break;
+				case animationCommand:
+					animations->play(enemies.sprite[i], command.clip, command.loop);
+					break;
+				case restartAnimationCommand:
+					animations->restart(enemies.sprite[i]);
+					break;
+			}
+		}
+		commandBuffers[chunk].clear();
+	}
+}
+
+void EnemyManager::damageEnemies(const Player& player, Map& map)
+{
+	if (!player.justShot) {
+		return;
+	}
+	double distance;
+	int target = traceShot(player, map, distance);
+	if (target < 0) {
+		return;
+	}
+	int range = player.weapon->getRange();
+	int damage = player.weapon->getDamage() * (range - distance) / range;
+	if (damage < 0) {
+		damage = 0;
+	}
+	takeDamage(target, damage);
+}
+
+int EnemyManager::traceShot(const Player& player, Map& map, double& distance)
+{
+	RayCaster raycaster;
+	Point2D playerPosition = player.position;
+	RayCastResult ray = raycaster.rayCast(player.angle, playerPosition, map);
+
+	//only enemies close to the shot's path, up to the wall it hits, can be hit
+	Point2D hitPoint = { playerPosition.x + cos(player.angle) * ray.depth, playerPosition.y + sin(player.angle) * ray.depth };
+	nearby.clear();
+	enemies.grid.querySegment(playerPosition, hitPoint, CROSSHAIR_SEARCH_RADIUS, nearby);
+	int target = -1;
+	distance = ray.depth;
+	for (int slot : nearby) {
+		int i = enemies.indexOfSlot(slot);
+		if (i < 0 || !enemies.isAlive(i)) {
+			continue;
+		}
+		double entry = hitDistance(i, player);
+		if (entry >= 0 && entry < distance) {
+			target = i;
+			distance = entry;
+		}
+	}
+	return target;
+}
+
+void EnemyManager::takeDamage(int index, int damage)
+{
+	enemies.hurt[index] = 1;
+	if (enemies.health[index] - damage < 0) {
+		enemies.health[index] = 0;
+	}
+	else {
+		enemies.health[index] -= damage;
+	}
+
+	bool alive = enemies.isAlive(index);
+	SoundId sound;
+	if (enemies.type[index] == melee) {
+		sound = alive ? demonHurtSound : demonDeathSound;
+	}
+	else {
+		sound = alive ? zombieHurtSound : zombieDeathSound;
+	}
+	//a shotgun blast hurting a crowd is one sound, the queue collapses the repeats
+	AudioSystem::getInstance()->playAt(sound, enemies.position[index]);
+
+	if (!alive) {
+		raiseAlarm(enemies.position[index]);
+	}
+}
+
+void EnemyManager::raiseAlarm(Point2D position)
+{
+	//enemies that hear a death go check on the body before resuming the chase
+	nearby.clear();
+	enemies.grid.queryRadius(position, ALARM_RADIUS, nearby);
+	for (int slot : nearby) {
+		int i = enemies.indexOfSlot(slot);
+		if (i < 0 || !enemies.isAlive(i) || enemies.playerDistance[i] < enemies.wallDistance[i]) {
+			continue;
+		}
+		enemies.goal[i] = position;
+		enemies.hasGoal[i] = 1;
+		enemies.sleeping[i] = 0;
+	}
+}
+
+double EnemyManager::hitDistance(int index, const Player& player)
+{
+	Point2D d;
+	d.x = enemies.position[index].x - player.position.x;
+	d.y = enemies.position[index].y - player.position.y;
+	double forward = d.x * cos(player.angle) + d.y * sin(player.angle);
+	double side = d.y * cos(player.angle) - d.x * sin(player.angle);
+
+	//the bounding circle's radius is half the world width of the current frame
+	const Animated& sprite = enemies.sprite[index];
+	Texture texture = sprite.tex;
+	int frames = 1;
+	if (sprite.animationIndex < (int)sprite.animations.size()) {
+		texture = sprite.animations[sprite.animationIndex]->texture;
+		frames = sprite.animations[sprite.animationIndex]->numFrames;
+	}
+	if (texture.height <= 0) {
+		return -1;
+	}
+	double radius = sprite.scale * texture.width / texture.height / frames / 2;
+	if (forward <= 0 || std::abs(side) >= radius) {
+		return -1;
+	}
+	//where the ray enters the circle, clamped for a player standing inside it
+	return std::max(0.0, forward - sqrt(radius * radius - side * side));
+}
+
+void EnemyManager::setEnemyState(int index, std::vector<EnemyCommand>& commands)
+{
+	AnimationSystem* animations = AnimationSystem::getInstance();
+	Animated& sprite = enemies.sprite[index];
+	if (enemies.isAlive(index) && enemies.hurt[index]) {
+		commands.push_back({ animationCommand, index, 1, false, soundCount });
+		//the hurt clip starts over when it's switched to, so it can only be done if it was already playing
+		if (sprite.animationIndex == 1 && animations->isDone(sprite)) {
+			commands.push_back({ restartAnimationCommand, index, 0, false, soundCount });
+			enemies.hurt[index] = 0;
+		}
+	}
+	else if (!enemies.isAlive(index)) {
+		//the death animation doesn't loop, it holds its last frame
+		commands.push_back({ animationCommand, index, 2, false, soundCount });
+	}
+	else {
+		commands.push_back({ animationCommand, index, 0, true, soundCount });
 	}
 }
@@ -1,7 +1,40 @@
 #pragma once
 
 #include <vector>
-#include "Enemy.h"
+#include "EnemyStore.h"
+#include "Player.h"
+#include "ProjectilePool.h"
+#include "FlowField.h"
+#include "HierarchicalPathfinder.h"
+#include "HordeSpawner.h"
+#include "RayCaster.h"
+#define CROSSHAIR_SEARCH_RADIUS 1.0
+#define ALARM_RADIUS 12.0
+#define AI_NEAR_STEPS 12
+#define AI_THINK_BUDGET 32
+#define AI_WAKE_RADIUS 4.0
+#define AI_NOISE_RADIUS 16.0
+#define ENEMY_JOB_CHUNK 64
+#define SEPARATION_RADIUS 0.6
+#define SEPARATION_WEIGHT 1.5
+#define SEPARATION_MAX_NEIGHBOURS 8
+#define ARRIVAL_RADIUS 1.0
+#define ARRIVAL_STOP_DISTANCE 0.4
+
+/**
+ * @struct EnemyCommand
+ * @brief Efecto de un enemigo fuera de sus propios datos, guardado para aplicarlo despus.
+ *
+ * Los trabajos en paralelo no tocan al jugador, al sonido, a los proyectiles ni a las
+ * animaciones: anotan lo que quieren hacer y `EnemyManager` lo aplica al final.
+ */
+struct EnemyCommand {
+    EnemyCommandType type; ///< Qu hacer.
+    int enemy;             ///< ndice del enemigo que lo pide.
+    int clip;              ///< Animacin a reproducir (`animationCommand`).
+    bool loop;             ///< Si la animacin se repite (`animationCommand`).
+    SoundId sound;         ///< Sonido a reproducir (`soundCommand`).
+};
 
 /**
  * @class EnemyManager
@@ -9,76 +42,290 @@
  *
  * La clase `EnemyManager` se encarga de manejar una lista de enemigos,
  * inicializarlos, gestionar su comportamiento, aplicar dao y verificar su estado.
+ * Los enemigos se guardan en un `EnemyStore` y cada comportamiento (movimiento, ataque,
+ * dao y animacin) es un sistema que recorre todos los enemigos en un solo ciclo.
+ * El movimiento, el ataque y la animacin corren en paralelo con `JobSystem`, en bloques
+ * de `ENEMY_JOB_CHUNK` enemigos; cada bloque escribe solo en sus enemigos y anota el
+ * resto en su propio bfer de `EnemyCommand`.
  */
 class EnemyManager {
 public:
     /**
-     * @brief Obtiene la lista de enemigos actuales.
+     * @brief Obtiene los enemigos actuales.
      *
-     * @return Un puntero a un vector de enemigos (`Enemy*`).
+     * @return Un puntero al almacn de enemigos.
      */
-    std::vector<Enemy*>* getEnemyList();
+    EnemyStore* getEnemies();
+
+    /**
+     * @brief Obtiene los proyectiles disparados por los enemigos.
+     *
+     * @return Conjunto de proyectiles en vuelo.
+     */
+    ProjectilePool* getProjectiles();
 
     /**
      * @brief Inicializa los enemigos en el nivel actual.
      *
      * Este mtodo crea nuevos enemigos basndose en objetos del nivel,
-     * asignndoles sprites y animaciones especficas segn su tipo.
+     * asignndoles sprites y animaciones especficas segn su tipo, y carga las
+     * oleadas del nivel. En el escenario de prueba de carga crea solo la horda de prueba.
      */
     void initEnemies();
 
     /**
      * @brief Limpia la lista de enemigos.
      *
-     * Libera la memoria asignada para los enemigos actuales y vaca la lista.
+     * Elimina los enemigos y los proyectiles actuales.
      */
     void clearEnemies();
 
     /**
      * @brief Ejecuta el comportamiento de todos los enemigos.
      *
-     * Este mtodo actualiza el estado de cada enemigo en la lista, aplica dao
-     * cuando sea necesario y actualiza sus animaciones.
+     * Ejecuta en orden los sistemas de movimiento y ataque (en paralelo), proyectiles,
+     * dao y animacin (en paralelo), cada uno sobre todos los enemigos. Los bferes de
+     * comandos se aplican en el orden de los bloques, as que el resultado no depende de
+     * qu hilo proces cada bloque.
      *
      * @param player Referencia al jugador.
      * @param map Mapa del nivel actual.
      */
-    void runEnemyBehaviour(Player& player, Map map);
+    void runEnemyBehaviour(Player& player, Map& map);
 
     /**
      * @brief Verifica si todos los enemigos estn muertos.
      *
-     * @return `true` si todos los enemigos estn muertos, `false` en caso contrario.
+     * @return `true` si todos los enemigos estn muertos y no quedan oleadas por venir.
      */
     bool areEnemiesDead();
 
+    /**
+     * @brief Activa el escenario de prueba de carga a partir del prximo nivel cargado.
+     *
+     * @param count Cantidad de enemigos de la horda de prueba, o 0 para jugar normalmente.
+     */
+    void setStressCount(int count);
+
+    /**
+     * @brief Cambia la semilla de las decisiones al azar de los enemigos.
+     *
+     * Con la misma semilla, cada nivel crea los mismos enemigos en los mismos lugares.
+     *
+     * @param seed Semilla; se usa a partir del prximo nivel cargado.
+     */
+    void setSeed(unsigned int seed);
+
+    /**
+     * @brief Obtiene la semilla de las decisiones al azar de los enemigos.
+     * @return Semilla actual.
+     */
+    unsigned int getSeed();
+
+    /**
+     * @brief Guarda los enemigos, los proyectiles y el avance de las oleadas.
+     *
+     * @param out Destino.
+     */
+    void save(StateWriter& out);
+
+    /**
+     * @brief Restaura lo que guard `save` en el nivel actual.
+     *
+     * Los caminos y el campo de direcciones se recalculan solos porque el mapa cambia
+     * de revisin al cargarse.
+     *
+     * @param in Origen.
+     * @return false si faltaban datos.
+     */
+    bool load(StateReader& in);
+
+    /**
+     * @brief Construye el gestor sin enemigos.
+     */
+    EnemyManager();
+
 private:
     /**
-     * @brief Aplica dao a un enemigo, si corresponde.
+     * @brief Decide qu enemigos piensan en este tick.
      *
-     * Este mtodo determina si un enemigo puede recibir dao basado en
-     * la posicin, distancia y el estado del jugador (si dispar recientemente).
+     * Los que ven al jugador, tienen un `EnemyStore::goal` o estn a menos de
+     * `AI_NEAR_STEPS` pasos piensan en cada tick. Los lejanos piensan cada
+     * `AI_THINK_INTERVAL` segundos, y como mucho `AI_THINK_BUDGET` de ellos por tick,
+     * turnndose; entre un pensamiento y otro siguen caminando en la ltima direccin.
+     * Los dormidos no hacen nada hasta que se abre una puerta hacia ellos, el jugador
+     * dispara a menos de `AI_NOISE_RADIUS` o se acerca a menos de `AI_WAKE_RADIUS`.
+     * Los que tienen un objetivo piensan aqu mismo, porque `pathfinder` no se comparte
+     * entre hilos.
      *
-     * @param enemy Puntero al enemigo que podra recibir dao.
      * @param player Referencia al jugador.
      * @param map Mapa del nivel actual.
+     * @param deltaTime Duracin del tick en segundos.
      */
-    void damageEnemy(Enemy* enemy, Player player, Map map);
+    void scheduleEnemies(const Player& player, Map& map, double deltaTime);
 
     /**
-     * @brief Actualiza el estado visual del enemigo.
+     * @brief Guarda la posicin inicial del tick de un enemigo y lo hace pensar si le toca.
+     *
+     * Solo escribe en los datos del enemigo, as que puede correr en paralelo.
+     *
+     * @param index ndice del enemigo.
+     * @param player Referencia al jugador.
+     * @param map Mapa del nivel actual.
+     * @param rayCaster Lanzador de rayos del hilo.
+     */
+    void decideEnemy(int index, const Player& player, Map& map, RayCaster& rayCaster);
+
+    /**
+     * @brief Verifica si un enemigo est vivo, despierto y libre para caminar.
+     *
+     * @param index ndice del enemigo.
+     * @return true si no est muerto, herido, por disparar ni dormido.
+     */
+    bool isEnemyActive(int index);
+
+    /**
+     * @brief Calcula la velocidad de un enemigo para este tick.
+     *
+     * Parte de la direccin que decidi al pensar, frena al llegar al jugador o a su
+     * `EnemyStore::goal`, y suma un empuje para separarse de los vecinos vivos a menos de
+     * `SEPARATION_RADIUS`. Los vecinos salen de `EnemyStore::grid` y solo cuentan los
+     * primeros `SEPARATION_MAX_NEIGHBOURS` en el orden de sus celdas, no los ms cercanos,
+     * as que el costo no crece con el tamao de la horda. Solo escribe en
+     * `EnemyStore::velocity` del enemigo.
+     *
+     * @param index ndice del enemigo.
+     * @param player Referencia al jugador.
+     * @param neighbours Vector de trabajo del bloque para la consulta de vecinos.
+     */
+    void steerEnemy(int index, const Player& player, std::vector<int>& neighbours);
+
+    /**
+     * @brief Avanza un enemigo un tick segn su `EnemyStore::velocity`, deslizndose por las paredes.
+     *
+     * `EnemyStore::grid` se actualiza despus, fuera de los trabajos.
      *
-     * Cambia la animacin del enemigo segn su estado actual:
+     * @param index ndice del enemigo.
+     * @param map Mapa del nivel actual.
+     * @param deltaTime Duracin del tick en segundos.
+     */
+    void moveEnemy(int index, Map& map, double deltaTime);
+
+    /**
+     * @brief Decide hacia dnde camina un enemigo.
+     *
+     * Los que ven al jugador caminan en lnea recta; los que tienen un `EnemyStore::goal`
+     * van hacia l con `pathfinder`, y los dems siguen `flowField`. Ambos rodean paredes
+     * y puertas cerradas. Guarda la distancia al jugador y a la pared ms cercana en su
+     * direccin, que luego usa el sistema de ataque, y duerme al enemigo si no tiene
+     * camino hasta el jugador.
+     *
+     * @param index ndice del enemigo.
+     * @param player Referencia al jugador.
+     * @param map Mapa del nivel actual.
+     * @param rayCaster Lanzador de rayos del hilo.
+     */
+    void thinkEnemy(int index, const Player& player, Map& map, RayCaster& rayCaster);
+
+    /**
+     * @brief Despierta a los enemigos cercanos a una posicin.
+     *
+     * @param position Centro de la zona.
+     * @param radius Radio de la zona.
+     */
+    void wakeEnemies(Point2D position, double radius);
+
+    /**
+     * @brief Un enemigo ataca al jugador: cuerpo a cuerpo si est cerca, o disparando proyectiles.
+     *
+     * El dao, el disparo y el sonido se anotan en `commands`.
+     *
+     * @param index ndice del enemigo.
+     * @param player Referencia al jugador.
+     * @param deltaTime Duracin del tick en segundos.
+     * @param commands Bfer del bloque al que pertenece el enemigo.
+     */
+    void attackPlayer(int index, const Player& player, double deltaTime, std::vector<EnemyCommand>& commands);
+
+    /**
+     * @brief Aplica y vaca los bferes de comandos, en el orden de los bloques.
+     *
+     * @param player Jugador que recibe el dao.
+     * @param chunks Cantidad de bloques del ltimo trabajo.
+     */
+    void executeCommands(Player& player, int chunks);
+
+    /**
+     * @brief Aplica el disparo del jugador al enemigo que alcanza.
+     *
+     * El disparo no atraviesa enemigos: solo recibe dao el primero de la trayectoria.
+     *
+     * @param player Referencia al jugador.
+     * @param map Mapa del nivel actual.
+     */
+    void damageEnemies(const Player& player, Map& map);
+
+    /**
+     * @brief Traza el rayo del disparo y busca el enemigo ms cercano que alcanza.
+     *
+     * Se lanza un solo rayo por disparo para saber hasta dnde llega antes de chocar con
+     * una pared, y solo se prueban los enemigos que `EnemyStore::grid` encuentra cerca de
+     * su trayectoria. No depende de lo que se dibuj en pantalla.
+     *
+     * @param player Jugador que dispara.
+     * @param map Mapa del nivel actual.
+     * @param distance Recibe la distancia al impacto (al enemigo o a la pared).
+     * @return ndice del enemigo alcanzado, o -1 si el disparo dio en una pared.
+     */
+    int traceShot(const Player& player, Map& map, double& distance);
+
+    /**
+     * @brief Aplica dao a un enemigo y reproduce su sonido de herida o muerte.
+     *
+     * @param index ndice del enemigo.
+     * @param damage Cantidad de dao.
+     */
+    void takeDamage(int index, int damage);
+
+    /**
+     * @brief Enva a investigar un lugar a los enemigos cercanos que no ven al jugador.
+     *
+     * @param position Lugar de la alarma.
+     */
+    void raiseAlarm(Point2D position);
+
+    /**
+     * @brief Actualiza el estado visual de un enemigo.
+     *
+     * Anota en `commands` la animacin segn su estado actual:
      * - Animacin de herido si est herido.
      * - Animacin de muerte si est muerto.
      * - Animacin de caminar si est vivo y saludable.
      *
-     * @param enemy Puntero al enemigo cuyo estado se actualizar.
+     * @param index ndice del enemigo.
+     * @param commands Bfer del bloque al que pertenece el enemigo.
      */
-    void setEnemyState(Enemy* enemy);
+    void setEnemyState(int index, std::vector<EnemyCommand>& commands);
 
     /**
-     * @brief Lista de enemigos actuales en el nivel.
+     * @brief Calcula dnde entra el rayo del disparo en el crculo que ocupa un enemigo.
+     *
+     * El radio del crculo es la mitad del ancho de su sprite en el mundo.
+     *
+     * @param index ndice del enemigo a comprobar.
+     * @param player Jugador que dispara.
+     * @return Distancia desde el jugador hasta el punto de entrada, o -1 si el rayo no lo toca.
      */
-    std::vector<Enemy*> enemyList;
+    double hitDistance(int index, const Player& player);
+
+    EnemyStore enemies;                    ///< Enemigos del nivel actual.
+    ProjectilePool projectiles;            ///< Proyectiles disparados por los enemigos a distancia.
+    FlowField flowField;                   ///< Caminos hacia la celda del jugador.
+    HierarchicalPathfinder pathfinder;     ///< Caminos de cada enemigo hacia su `EnemyStore::goal`.
+    HordeSpawner spawner;                  ///< Oleadas del nivel y escenario de prueba de carga.
+    int thinkCursor;                       ///< Enemigo por el que empieza el turno de los lejanos.
+    std::vector<uint8_t> thinkNow;         ///< 1 si el enemigo piensa en este tick.
+    std::vector<std::vector<EnemyCommand>> commandBuffers; ///< Bfer de comandos de cada bloque.
+    std::vector<std::vector<int>> neighbourBuffers; ///< Vecinos consultados por cada bloque, reutilizados.
+    std::vector<int> nearby;               ///< Resultados de las consultas a `EnemyStore::grid`, reutilizados.
 };
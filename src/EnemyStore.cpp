@@ -0,0 +1,279 @@
+#include "EnemyStore.h"
+#include "TextureManager.h"
+#include "AnimationLibrary.h"
+#include "AnimationSystem.h"
+
+EnemyHandle EnemyStore::spawn(EnemyType type, Point2D position)
+{
+	int slot;
+	if (!freeSlots.empty()) {
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	else {
+		slot = slotIndex.size();
+		slotIndex.push_back(-1);
+		slotGeneration.push_back(0);
+	}
+	int index = this->position.size();
+	slotIndex[slot] = index;
+	indexSlot.push_back(slot);
+
+	this->position.push_back(position);
+	previousPosition.push_back(position);
+	angle.push_back(0);
+	health.push_back(100);
+	damage.push_back(10);
+	this->type.push_back(type);
+	hurt.push_back(0);
+	attacking.push_back(0);
+	attackTimer.push_back(0);
+	playerDistance.push_back(0);
+	wallDistance.push_back(0);
+	goal.push_back(position);
+	hasGoal.push_back(0);
+	sleeping.push_back(0);
+	moving.push_back(0);
+	velocity.push_back({ 0, 0 });
+	//new enemies think on their first tick
+	thinkTimer.push_back(AI_THINK_INTERVAL);
+
+	AnimationLibrary* animLib = AnimationLibrary::getInstance();
+	Animated enemySprite = {};
+	enemySprite.tex = TextureManager::getInstance()->getTexture("");
+	enemySprite.animationIndex = 0;
+	enemySprite.position = position;
+	switch (type) {
+		case melee:
+			speed.push_back(4);
+			enemySprite.scale = 0.9;
+			enemySprite.shift = 0.1;
+			enemySprite.animations.push_back(animLib->getAnimation("demon_walk"));
+			enemySprite.animations.push_back(animLib->getAnimation("demon_hurt"));
+			enemySprite.animations.push_back(animLib->getAnimation("demon_death"));
+			break;
+		case range:
+			speed.push_back(1);
+			enemySprite.scale = 1;
+			enemySprite.shift = 0;
+			enemySprite.animations.push_back(animLib->getAnimation("zombie_walk"));
+			enemySprite.animations.push_back(animLib->getAnimation("zombie_hurt"));
+			enemySprite.animations.push_back(animLib->getAnimation("zombie_death"));
+			break;
+	}
+	sprite.push_back(enemySprite);
+	grid.insert(slot, position);
+	AnimationSystem::getInstance()->play(sprite.back(), 0, true);
+
+	return { slot, slotGeneration[slot] };
+}
+
+void EnemyStore::despawn(EnemyHandle handle)
+{
+	int index = indexOf(handle);
+	if (index < 0) {
+		return;
+	}
+	AnimationSystem::getInstance()->release(sprite[index]);
+
+	//move the last enemy into the hole so the arrays stay packed
+	int last = size() - 1;
+	position[index] = position[last];
+	previousPosition[index] = previousPosition[last];
+	angle[index] = angle[last];
+	health[index] = health[last];
+	damage[index] = damage[last];
+	speed[index] = speed[last];
+	type[index] = type[last];
+	hurt[index] = hurt[last];
+	attacking[index] = attacking[last];
+	attackTimer[index] = attackTimer[last];
+	playerDistance[index] = playerDistance[last];
+	wallDistance[index] = wallDistance[last];
+	goal[index] = goal[last];
+	hasGoal[index] = hasGoal[last];
+	sleeping[index] = sleeping[last];
+	moving[index] = moving[last];
+	velocity[index] = velocity[last];
+	thinkTimer[index] = thinkTimer[last];
+	sprite[index] = sprite[last];
+	indexSlot[index] = indexSlot[last];
+	slotIndex[indexSlot[index]] = index;
+
+	position.pop_back();
+	previousPosition.pop_back();
+	angle.pop_back();
+	health.pop_back();
+	damage.pop_back();
+	speed.pop_back();
+	type.pop_back();
+	hurt.pop_back();
+	attacking.pop_back();
+	attackTimer.pop_back();
+	playerDistance.pop_back();
+	wallDistance.pop_back();
+	goal.pop_back();
+	hasGoal.pop_back();
+	sleeping.pop_back();
+	moving.pop_back();
+	velocity.pop_back();
+	thinkTimer.pop_back();
+	sprite.pop_back();
+	indexSlot.pop_back();
+
+	grid.remove(handle.slot);
+	slotIndex[handle.slot] = -1;
+	slotGeneration[handle.slot]++;
+	freeSlots.push_back(handle.slot);
+}
+
+void EnemyStore::clear()
+{
+	AnimationSystem* animations = AnimationSystem::getInstance();
+	for (auto& enemySprite : sprite) {
+		animations->release(enemySprite);
+	}
+	for (int slot : indexSlot) {
+		slotIndex[slot] = -1;
+		slotGeneration[slot]++;
+		freeSlots.push_back(slot);
+	}
+	position.clear();
+	previousPosition.clear();
+	angle.clear();
+	health.clear();
+	damage.clear();
+	speed.clear();
+	type.clear();
+	hurt.clear();
+	attacking.clear();
+	attackTimer.clear();
+	playerDistance.clear();
+	wallDistance.clear();
+	goal.clear();
+	hasGoal.clear();
+	sleeping.clear();
+	moving.clear();
+	velocity.clear();
+	thinkTimer.clear();
+	sprite.clear();
+	indexSlot.clear();
+	grid.clear();
+}
+
+bool EnemyStore::isValid(EnemyHandle handle) const
+{
+	return indexOf(handle) >= 0;
+}
+
+int EnemyStore::indexOf(EnemyHandle handle) const
+{
+	if (handle.slot < 0 || handle.slot >= (int)slotIndex.size() || slotGeneration[handle.slot] != handle.generation) {
+		return -1;
+	}
+	return slotIndex[handle.slot];
+}
+
+EnemyHandle EnemyStore::getHandle(int index) const
+{
+	int slot = indexSlot[index];
+	return { slot, slotGeneration[slot] };
+}
+
+int EnemyStore::getSlot(int index) const
+{
+	return indexSlot[index];
+}
+
+int EnemyStore::indexOfSlot(int slot) const
+{
+	if (slot < 0 || slot >= (int)slotIndex.size()) {
+		return -1;
+	}
+	return slotIndex[slot];
+}
+
+int EnemyStore::size() const
+{
+	return position.size();
+}
+
+bool EnemyStore::isAlive(int index) const
+{
+	return health[index] > 0;
+}
+
+void EnemyStore::save(StateWriter& out)
+{
+	int count = size();
+	out.writeArray(type);
+	out.writeBlock(position.data(), count);
+	out.writeBlock(previousPosition.data(), count);
+	out.writeBlock(angle.data(), count);
+	out.writeBlock(health.data(), count);
+	out.writeBlock(damage.data(), count);
+	out.writeBlock(speed.data(), count);
+	out.writeBlock(hurt.data(), count);
+	out.writeBlock(attacking.data(), count);
+	out.writeBlock(attackTimer.data(), count);
+	out.writeBlock(playerDistance.data(), count);
+	out.writeBlock(wallDistance.data(), count);
+	out.writeBlock(goal.data(), count);
+	out.writeBlock(hasGoal.data(), count);
+	out.writeBlock(sleeping.data(), count);
+	out.writeBlock(moving.data(), count);
+	out.writeBlock(velocity.data(), count);
+	out.writeBlock(thinkTimer.data(), count);
+	AnimationSystem* animations = AnimationSystem::getInstance();
+	for (int i = 0; i < count; i++) {
+		animations->save(sprite[i], out);
+	}
+}
+
+bool EnemyStore::load(StateReader& in)
+{
+	clear();
+	std::vector<EnemyType> types;
+	if (!in.readArray(types)) {
+		return false;
+	}
+	for (EnemyType type : types) {
+		if (type != melee && type != range) {
+			return false;
+		}
+	}
+	//spawning sets up each sprite for its type, the saved arrays then overwrite the defaults
+	int count = types.size();
+	for (int i = 0; i < count; i++) {
+		spawn(types[i], { 0, 0 });
+	}
+	bool ok = in.readBlock(position.data(), count) &&
+		in.readBlock(previousPosition.data(), count) &&
+		in.readBlock(angle.data(), count) &&
+		in.readBlock(health.data(), count) &&
+		in.readBlock(damage.data(), count) &&
+		in.readBlock(speed.data(), count) &&
+		in.readBlock(hurt.data(), count) &&
+		in.readBlock(attacking.data(), count) &&
+		in.readBlock(attackTimer.data(), count) &&
+		in.readBlock(playerDistance.data(), count) &&
+		in.readBlock(wallDistance.data(), count) &&
+		in.readBlock(goal.data(), count) &&
+		in.readBlock(hasGoal.data(), count) &&
+		in.readBlock(sleeping.data(), count) &&
+		in.readBlock(moving.data(), count) &&
+		in.readBlock(velocity.data(), count) &&
+		in.readBlock(thinkTimer.data(), count);
+	if (!ok) {
+		return false;
+	}
+	AnimationSystem* animations = AnimationSystem::getInstance();
+	for (int i = 0; i < count; i++) {
+		sprite[i].position = position[i];
+		grid.update(getSlot(i), position[i]);
+		if (!animations->load(sprite[i], in)) {
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,157 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "Point2D.h"
+#include "Animated.h"
+#include "Enumerations.h"
+#include "SpatialGrid.h"
+#include "SaveState.h"
+#define RANGED_ATTACK_COOLDOWN 5
+#define MELEE_RANGE 0.5
+#define AI_THINK_INTERVAL 0.25
+
+/**
+ * @struct EnemyHandle
+ * @brief Referencia estable a un enemigo del `EnemyStore`.
+ *
+ * Sigue siendo válida aunque otros enemigos se eliminen y los arreglos se reordenen;
+ * deja de serlo cuando el enemigo al que apunta se elimina.
+ */
+struct EnemyHandle {
+    int slot;                ///< Espacio del enemigo en la tabla de índices.
+    unsigned int generation; ///< Generación del espacio cuando se creó el handle.
+};
+
+/**
+ * @class EnemyStore
+ * @brief Almacena todos los enemigos como arreglos paralelos (estructura de arreglos).
+ *
+ * Cada atributo de los enemigos vive en su propio arreglo contiguo, y el enemigo `i`
+ * ocupa la posición `i` de todos ellos. Los sistemas de `EnemyManager` recorren solo
+ * los arreglos que necesitan, sin punteros por enemigo ni llamadas virtuales.
+ * Al eliminar un enemigo, el último ocupa su lugar; por eso las referencias externas
+ * deben usar `EnemyHandle` en vez del índice.
+ */
+class EnemyStore {
+public:
+    std::vector<Point2D> position;      ///< Posición en el mundo.
+    std::vector<Point2D> previousPosition; ///< Posición al empezar el tick, para interpolar el dibujo.
+    std::vector<double> angle;          ///< Dirección hacia el jugador en radianes.
+    std::vector<int> health;            ///< Vida restante; 0 si está muerto.
+    std::vector<int> damage;            ///< Daño que inflige al jugador.
+    std::vector<double> speed;          ///< Velocidad en celdas por segundo.
+    std::vector<EnemyType> type;        ///< Tipo del enemigo.
+    std::vector<uint8_t> hurt;          ///< 1 mientras se reproduce la animación de herido.
+    std::vector<uint8_t> attacking;     ///< 1 si un enemigo a distancia va a disparar en el próximo tick.
+    std::vector<double> attackTimer;    ///< Tiempo desde el último disparo.
+    std::vector<double> playerDistance; ///< Distancia al jugador calculada en el último tick.
+    std::vector<double> wallDistance;   ///< Distancia a la pared más cercana en dirección al jugador.
+    std::vector<Point2D> goal;          ///< Lugar al que va el enemigo mientras no ve al jugador.
+    std::vector<uint8_t> hasGoal;       ///< 1 si el enemigo tiene un `goal` pendiente.
+    std::vector<uint8_t> sleeping;      ///< 1 si el enemigo no tiene camino al jugador y no se actualiza.
+    std::vector<uint8_t> moving;        ///< 1 si en su último pensamiento decidió caminar.
+    std::vector<Point2D> velocity;      ///< Velocidad de este tick, después de esquivar a los vecinos.
+    std::vector<double> thinkTimer;     ///< Tiempo desde su último pensamiento.
+    std::vector<Animated> sprite;       ///< Sprite de cada enemigo, guardado por valor.
+    SpatialGrid grid;                   ///< Índice espacial de los enemigos, por espacio (`getSlot`).
+
+    /**
+     * @brief Agrega un enemigo con los atributos por defecto de su tipo.
+     *
+     * @param type Tipo del enemigo.
+     * @param position Posición inicial.
+     * @return Handle del nuevo enemigo.
+     */
+    EnemyHandle spawn(EnemyType type, Point2D position);
+
+    /**
+     * @brief Elimina un enemigo; el último enemigo pasa a ocupar su índice.
+     *
+     * @param handle Handle del enemigo a eliminar.
+     */
+    void despawn(EnemyHandle handle);
+
+    /**
+     * @brief Elimina todos los enemigos e invalida todos los handles.
+     */
+    void clear();
+
+    /**
+     * @brief Verifica si un handle todavía apunta a un enemigo existente.
+     *
+     * @param handle Handle a comprobar.
+     * @return true si el enemigo existe.
+     */
+    bool isValid(EnemyHandle handle) const;
+
+    /**
+     * @brief Obtiene el índice actual de un enemigo en los arreglos.
+     *
+     * @param handle Handle del enemigo.
+     * @return Índice del enemigo, o -1 si el handle ya no es válido.
+     */
+    int indexOf(EnemyHandle handle) const;
+
+    /**
+     * @brief Obtiene el handle del enemigo que ocupa un índice.
+     *
+     * @param index Índice en los arreglos.
+     * @return Handle estable del enemigo.
+     */
+    EnemyHandle getHandle(int index) const;
+
+    /**
+     * @brief Obtiene el espacio estable del enemigo que ocupa un índice.
+     *
+     * Es el identificador con el que el enemigo está en `grid`.
+     *
+     * @param index Índice en los arreglos.
+     * @return Espacio del enemigo.
+     */
+    int getSlot(int index) const;
+
+    /**
+     * @brief Obtiene el índice actual del enemigo que ocupa un espacio.
+     *
+     * @param slot Espacio del enemigo, por ejemplo uno devuelto por `grid`.
+     * @return Índice en los arreglos, o -1 si el espacio está libre.
+     */
+    int indexOfSlot(int slot) const;
+
+    /**
+     * @brief Cantidad de enemigos.
+     * @return Número de enemigos en los arreglos.
+     */
+    int size() const;
+
+    /**
+     * @brief Verifica si un enemigo sigue vivo.
+     *
+     * @param index Índice del enemigo.
+     * @return true si su vida es mayor que 0.
+     */
+    bool isAlive(int index) const;
+
+    /**
+     * @brief Guarda todos los enemigos, un arreglo detrás de otro.
+     *
+     * @param out Destino.
+     */
+    void save(StateWriter& out);
+
+    /**
+     * @brief Reemplaza los enemigos por los que guardó `save`.
+     *
+     * Los handles anteriores dejan de ser válidos.
+     *
+     * @param in Origen.
+     * @return false si faltaban datos.
+     */
+    bool load(StateReader& in);
+
+private:
+    std::vector<int> slotIndex;              ///< Índice en los arreglos de cada espacio, o -1 si está libre.
+    std::vector<unsigned int> slotGeneration; ///< Generación actual de cada espacio.
+    std::vector<int> indexSlot;              ///< Espacio de cada índice, para actualizar al reordenar.
+    std::vector<int> freeSlots;              ///< Espacios libres para reutilizar.
+};
@@ -63,3 +63,58 @@ enum GameState {
 	end = 6,        /**< Estado del final del juego. */
 	transition = 7, /**< Estado de transicin entre niveles o escenas. */
 };
+
+/**
+ * @enum RenderBackend
+ * @brief Representa los backends disponibles para renderizar la vista 3D.
+ *
+ * Se puede cambiar desde el men de opciones.
+ */
+enum RenderBackend {
+	gpuRendering = 0, /**< Cada columna y sprite se dibuja como un quad en la GPU. */
+	cpuRendering = 1, /**< La vista se rasteriza en CPU y se sube como una sola textura. */
+};
+
+/**
+ * @enum EnemyCommandType
+ * @brief Representa los efectos que un enemigo deja anotados para aplicar al final del tick.
+ */
+enum EnemyCommandType {
+	damagePlayerCommand = 0,     /**< Golpe cuerpo a cuerpo al jugador, con su sonido. */
+	soundCommand = 1,            /**< Reproducir un sonido en la posicin del enemigo. */
+	projectileCommand = 2,       /**< Disparar un proyectil desde el enemigo. */
+	animationCommand = 3,        /**< Cambiar la animacin del enemigo. */
+	restartAnimationCommand = 4, /**< Reiniciar la animacin actual del enemigo. */
+};
+
+/**
+ * @enum SoundId
+ * @brief Representa los efectos de sonido que la lgica del juego puede pedir a `AudioSystem`.
+ */
+enum SoundId {
+	walkSound = 0,              /**< Pasos del jugador. */
+	playerHurtSound = 1,        /**< El jugador recibe dao. */
+	reloadSound = 2,            /**< Disparo sin municin. */
+	healSound = 3,              /**< Recogida de vida. */
+	shootSound = 4,             /**< Disparo del jugador. */
+	ammoSound = 5,              /**< Recogida de municin. */
+	doorSound = 6,              /**< Una puerta se abre o se cierra. */
+	demonAttackSound = 7,       /**< Golpe de un enemigo cuerpo a cuerpo. */
+	demonHurtSound = 8,         /**< Un enemigo cuerpo a cuerpo es herido. */
+	demonDeathSound = 9,        /**< Un enemigo cuerpo a cuerpo muere. */
+	zombieHurtSound = 10,       /**< Un enemigo a distancia es herido. */
+	zombieDeathSound = 11,      /**< Un enemigo a distancia muere. */
+	zombieShootSound = 12,      /**< Un enemigo a distancia dispara. */
+	projectileExplodeSound = 13, /**< Un proyectil choca. */
+	soundCount = 14,            /**< Cantidad de sonidos. */
+};
+
+/**
+ * @enum SoundAction
+ * @brief Representa qu hace `AudioSystem` con un sonido al procesar su evento.
+ */
+enum SoundAction {
+	playAction = 0, /**< Reproducirlo desde el principio. */
+	idleAction = 1, /**< Reproducirlo solo si no est sonando. */
+	stopAction = 2, /**< Detenerlo. */
+};
\ No newline at end of file
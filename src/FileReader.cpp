@@ -1,17 +1,19 @@
 #define _CRT_SECURE_NO_WARNINGS
 #include <fstream>
 #include <cstring>
+#include <cstdlib>
+#include <cmath>
 #include <sstream>
 #include <string>
 #include <iostream>
 #include "FileReader.h"
 #include "Animated.h"
+#include "AnimationSystem.h"
+#include "AnimationLibrary.h"
 #include "TextureManager.h"
 #include "HealthBox.h"
 #include "AmmoBox.h"
 #include "Lamp.h"
-#include "MeleeEnemy.h"
-#include "RangedEnemy.h"
 
 bool FileReader::readMapFromFile(const char* fileName, WallType** map) {
     std::string path(fileName);
@@ -112,18 +114,10 @@ bool FileReader::readItemsFromFile(const char* fileName, std::vector<Item*>& ite
                 lampSprite->position = lamp->position;
                 lampSprite->tex = texMgr->getTexture("");
 
-                Animation red = {};
-                red.numFrames = 4;
-                red.animationSpeed = 2.0;
-                red.texture = texMgr->getTexture("sprites/animated/lamp.png");
-
-				Animation green = {};
-                green.numFrames = 4;
-                green.animationSpeed = 2.0;
-                green.texture = texMgr->getTexture("sprites/animated/lamp_green.png");
-
-                lampSprite->animations.push_back(red);
-                lampSprite->animations.push_back(green);
+                AnimationLibrary* animLib = AnimationLibrary::getInstance();
+                lampSprite->animations.push_back(animLib->getAnimation("lamp_red"));
+                lampSprite->animations.push_back(animLib->getAnimation("lamp_green"));
+                AnimationSystem::getInstance()->play(*lampSprite, 0, true);
 
                 lamp->sprite = lampSprite;
                 item = lamp;
@@ -140,3 +134,59 @@ bool FileReader::readItemsFromFile(const char* fileName, std::vector<Item*>& ite
     file.close();
     return true;
 }
+
+bool FileReader::readWavesFromFile(const char* fileName, std::vector<SpawnWave>& waves) {
+    std::string path(fileName);
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        std::cerr << "No se pudo abrir el archivo: " << fileName << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (getline(file, line))
+    {
+        //files saved on windows leave a \r at the end of each line
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos) {
+            continue;
+        }
+        line = line.substr(first, line.find_last_not_of(" \t\r") - first + 1);
+        //blank lines and comments document the file
+        if (line[0] == '#') {
+            continue;
+        }
+        std::stringstream ss(line);
+        std::string value;
+        std::vector<double> fields;
+        bool valid = true;
+        while (valid && getline(ss, value, ',')) {
+            char* end;
+            double number = strtod(value.c_str(), &end);
+            //strtod skips leading spaces itself, trailing ones are skipped here
+            while (*end == ' ' || *end == '\t') {
+                end++;
+            }
+            valid = end != value.c_str() && *end == '\0' && std::isfinite(number);
+            fields.push_back(number);
+        }
+        if (!valid || fields.size() < 8) {
+            std::cerr << "Oleada incompleta en " << fileName << ": " << line << std::endl;
+            continue;
+        }
+        SpawnWave wave;
+        wave.startTime = fields[0];
+        wave.count = (int)fields[1];
+        wave.rate = fields[2];
+        wave.meleeWeight = (int)fields[3];
+        wave.rangeWeight = (int)fields[4];
+        wave.zone = { fields[5], fields[6] };
+        wave.radius = fields[7];
+        wave.spawned = 0;
+        waves.push_back(wave);
+    }
+
+    file.close();
+    return true;
+}
@@ -2,7 +2,8 @@
 #include <vector>
 #include "Map.h"
 #include "Item.h"
-#include "Enemy.h"
+#include "EnemyStore.h"
+#include "HordeSpawner.h"
 
 /**
  * @class FileReader.h
@@ -47,15 +48,28 @@ public:
     static bool readItemsFromFile(const char* fileName, std::vector<Item*>& itemList);
 
     /**
-     * @brief Lee los datos de los enemigos desde un archivo y los carga en una lista.
+     * @brief Lee los datos de los enemigos desde un archivo y los carga en el almacn.
      *
      * @param fileName Nombre del archivo que contiene los datos de los enemigos.
-     * @param enemyList Vector donde se almacenarn los enemigos instanciados.
+     * @param enemies Almacn donde se crearn los enemigos.
      * @return `true` si el archivo se ley correctamente, `false` si ocurri un error.
      *
      * El archivo debe contener lneas con los datos de cada enemigo en el formato:
      * `EnemyType,posicinX,posicinY`. Se instanciar un enemigo basado en su tipo
-     * y se aadir a la lista proporcionada.
+     * y se aadir al almacn proporcionado.
+     */
+    static bool readEnemiesFromFile(const char* fileName, EnemyStore& enemies);
+
+    /**
+     * @brief Lee las oleadas de enemigos de un nivel desde un archivo `.wave`.
+     *
+     * @param fileName Nombre del archivo que contiene las oleadas.
+     * @param waves Vector donde se agregarn las oleadas ledas.
+     * @return `true` si el archivo se ley correctamente, `false` si ocurri un error.
+     *
+     * Cada lnea describe una oleada en el formato:
+     * `inicio,cantidad,ritmo,pesoMelee,pesoRange,zonaX,zonaY,radio`. Las lneas vacas
+     * y las que empiezan con `#` se ignoran.
      */
-    static bool readEnemiesFromFile(const char* fileName, std::vector<Enemy*>& enemyList);
+    static bool readWavesFromFile(const char* fileName, std::vector<SpawnWave>& waves);
 };
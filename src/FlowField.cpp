@@ -0,0 +1,108 @@
+#include <algorithm>
+#include "FlowField.h"
+
+bool FlowField::update(Map& map, Point2D target)
+{
+	int row = int(target.y);
+	int column = int(target.x);
+	if (row < 0 || row >= GRID_SIZE || column < 0 || column >= GRID_SIZE) {
+		return false;
+	}
+	int cell = row * GRID_SIZE + column;
+	if (cell == targetCell && map.getRevision() == mapRevision) {
+		return false;
+	}
+	rebuild(map, cell);
+	return true;
+}
+
+bool FlowField::getWaypoint(Point2D position, Point2D& waypoint) const
+{
+	int row = int(position.y);
+	int column = int(position.x);
+	if (row < 0 || row >= GRID_SIZE || column < 0 || column >= GRID_SIZE) {
+		return false;
+	}
+	int nextCell = next[row * GRID_SIZE + column];
+	if (nextCell < 0) {
+		return false;
+	}
+	waypoint = { nextCell % GRID_SIZE + 0.5, nextCell / GRID_SIZE + 0.5 };
+	return true;
+}
+
+int FlowField::getDistance(int row, int column) const
+{
+	if (row < 0 || row >= GRID_SIZE || column < 0 || column >= GRID_SIZE) {
+		return -1;
+	}
+	return distance[row * GRID_SIZE + column];
+}
+
+FlowField::FlowField()
+{
+	distance.assign(GRID_SIZE * GRID_SIZE, -1);
+	next.assign(GRID_SIZE * GRID_SIZE, -1);
+	queue.reserve(GRID_SIZE * GRID_SIZE);
+	targetCell = -1;
+	mapRevision = 0;
+}
+
+void FlowField::rebuild(Map& map, int cell)
+{
+	targetCell = cell;
+	mapRevision = map.getRevision();
+	std::fill(distance.begin(), distance.end(), -1);
+	std::fill(next.begin(), next.end(), -1);
+
+	//breadth first over the four sides, the target cell is walkable even if the player stands in a door
+	queue.clear();
+	queue.push_back(cell);
+	distance[cell] = 0;
+	const int sideRow[4] = { -1, 1, 0, 0 };
+	const int sideColumn[4] = { 0, 0, -1, 1 };
+	for (int head = 0; head < (int)queue.size(); head++) {
+		int current = queue[head];
+		int row = current / GRID_SIZE;
+		int column = current % GRID_SIZE;
+		for (int side = 0; side < 4; side++) {
+			int neighbourRow = row + sideRow[side];
+			int neighbourColumn = column + sideColumn[side];
+			if (!map.isPositionEmpty(neighbourRow, neighbourColumn)) {
+				continue;
+			}
+			int neighbour = neighbourRow * GRID_SIZE + neighbourColumn;
+			if (distance[neighbour] < 0) {
+				distance[neighbour] = distance[current] + 1;
+				queue.push_back(neighbour);
+			}
+		}
+	}
+
+	//every reached cell points at its closest neighbour, diagonals only when both sides are open
+	for (int current : queue) {
+		int row = current / GRID_SIZE;
+		int column = current % GRID_SIZE;
+		int best = distance[current];
+		for (int dRow = -1; dRow <= 1; dRow++) {
+			for (int dColumn = -1; dColumn <= 1; dColumn++) {
+				int neighbourRow = row + dRow;
+				int neighbourColumn = column + dColumn;
+				if ((dRow == 0 && dColumn == 0) || neighbourRow < 0 || neighbourRow >= GRID_SIZE
+					|| neighbourColumn < 0 || neighbourColumn >= GRID_SIZE) {
+					continue;
+				}
+				int neighbour = neighbourRow * GRID_SIZE + neighbourColumn;
+				if (distance[neighbour] < 0 || distance[neighbour] >= best) {
+					continue;
+				}
+				bool diagonal = dRow != 0 && dColumn != 0;
+				if (diagonal && (!map.isPositionEmpty(row + dRow, column) || !map.isPositionEmpty(row, column + dColumn))) {
+					continue;
+				}
+				best = distance[neighbour];
+				next[current] = neighbour;
+			}
+		}
+	}
+}
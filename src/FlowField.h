@@ -0,0 +1,64 @@
+#pragma once
+#include <vector>
+#include "Point2D.h"
+#include "Map.h"
+
+/**
+ * @class FlowField
+ * @brief Campo de direcciones hacia una celda del mapa, compartido por todos los enemigos.
+ *
+ * Un recorrido en anchura desde la celda objetivo (la del jugador) calcula, para cada
+ * celda transitable del nivel, la distancia en pasos y la celda vecina por la que
+ * conviene seguir. Así cualquier cantidad de enemigos encuentra su camino con una
+ * consulta de costo constante, y el campo solo se recalcula cuando el objetivo cambia
+ * de celda o cambia la revisión del mapa (por ejemplo al abrir o cerrar una puerta).
+ */
+class FlowField {
+public:
+    /**
+     * @brief Apunta el campo a una posición, recalculándolo solo si hace falta.
+     *
+     * @param map Mapa del nivel actual.
+     * @param target Posición objetivo, normalmente la del jugador.
+     * @return true si el campo se recalculó.
+     */
+    bool update(Map& map, Point2D target);
+
+    /**
+     * @brief Obtiene el próximo punto al que debe dirigirse quien está en una posición.
+     *
+     * @param position Posición actual.
+     * @param waypoint Centro de la siguiente celda del camino.
+     * @return false si la posición no tiene camino al objetivo o ya está en su celda.
+     */
+    bool getWaypoint(Point2D position, Point2D& waypoint) const;
+
+    /**
+     * @brief Distancia en pasos desde una celda hasta el objetivo.
+     *
+     * @param row Fila en la cuadrícula.
+     * @param column Columna en la cuadrícula.
+     * @return Cantidad de pasos, o -1 si la celda no tiene camino al objetivo.
+     */
+    int getDistance(int row, int column) const;
+
+    /**
+     * @brief Reserva las cuadrículas; el campo empieza sin objetivo.
+     */
+    FlowField();
+
+private:
+    std::vector<int> distance; ///< Pasos hasta el objetivo de cada celda, o -1.
+    std::vector<int> next;     ///< Celda siguiente del camino desde cada celda, o -1.
+    std::vector<int> queue;    ///< Cola del recorrido en anchura, reutilizada.
+    int targetCell;            ///< Celda objetivo del último cálculo, o -1.
+    unsigned int mapRevision;  ///< Revisión del mapa en el último cálculo.
+
+    /**
+     * @brief Recalcula distancias y direcciones desde una celda.
+     *
+     * @param map Mapa del nivel actual.
+     * @param cell Celda objetivo.
+     */
+    void rebuild(Map& map, int cell);
+};
@@ -1,5 +1,14 @@
 #include "Game.h"
 #include <iostream>
+#include <algorithm>
+#include <cmath>
+#include "GameClock.h"
+#include "AnimationSystem.h"
+#include "AudioSystem.h"
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iterator>
 
 void Game::startGame()
 {
@@ -11,6 +20,35 @@ GameState Game::getState()
 	return currentState;
 }
 
+void Game::setStressCount(int count)
+{
+	stressCount = count;
+	enemyManager.setStressCount(count);
+}
+
+void Game::setRecording(const char* fileName)
+{
+	recordFileName = fileName;
+}
+
+bool Game::setReplay(const char* fileName, bool uncapped)
+{
+	if (!replay.startPlayback(fileName)) {
+		return false;
+	}
+	//everything the simulation depends on besides the input comes from the file
+	const ReplayHeader& header = replay.getHeader();
+	enemyManager.setSeed(header.seed);
+	setStressCount(header.stressCount);
+	player->setSensibility(header.sensibility);
+	this->uncapped = uncapped;
+	if (uncapped) {
+		ClearWindowState(FLAG_VSYNC_HINT);
+		SetTargetFPS(0);
+	}
+	return true;
+}
+
 Game::Game()
 {
 	InitWindow(0, 0, "");
@@ -23,35 +61,233 @@ Game::Game()
 	soundMgr = SoundManager::getInstance();
 	soundMgr->loadSounds();
 	itemManager = ItemManager::getInstance();
+	lightMap = LightMap::getInstance();
 	currentLevel = 0;
 	map = Map::getInstance();
 	player = Player::getInstance();
 	currentState = mainMenu;
+	accumulator = 0;
+	simulatedTime = 0;
+	pendingInput = {};
+	stressCount = 0;
+	uncapped = false;
+	replayFrames = 0;
+	replayStart = 0;
 	currentSong = soundMgr->getSound("level1.mp3");
 }
 
 void Game::initGame()
 {
+	//every sprite is about to be rebuilt, start from an empty animation array
+	AnimationSystem::getInstance()->reset();
 	currentLevel = 0;
 	map->setLevel(currentLevel);
 	map->restoreMaps();
 	itemManager->setLevel(currentLevel);
 	itemManager->initItems();
-	enemyManager.initEnemies();
+	lightMap->bake(*map, *itemManager->getCurrentItemList());
+	//enemies are placed around the player's starting spot
 	player->reset();
+	enemyManager.initEnemies();
 }
 
 void Game::mainLoop()
 {
+	simulation.start([this](const InputFrame& input) { return simulate(input); },
+		[this](RenderSnapshot& snapshot) { snapshot.capture(*player, *map, *itemManager, enemyManager); });
 	while (!WindowShouldClose()) {
+		//input is only polled on the main thread, the ticks themselves run while this frame draws
+		if (currentState == playing) {
+			submitTicks();
+		}
+		GameState previousState = currentState;
 		render();
 		logic();
+		applySimulationState();
+		if (currentState == playing && previousState != playing) {
+			//don't draw a snapshot from before the level was (re)loaded
+			restartTicks();
+			if (previousState == mainMenu && !recordFileName.empty()) {
+				ReplayHeader header = {};
+				header.seed = enemyManager.getSeed();
+				header.stressCount = stressCount;
+				header.sensibility = player->getSensibility();
+				replay.startRecording(recordFileName.c_str(), header);
+				recordFileName.clear();
+			}
+			if (previousState == mainMenu && replay.isPlaying()) {
+				replayStart = GetTime();
+			}
+		}
 	}
+	simulation.stop();
 }
 
 void Game::render()
 {
-	newState = canvas.draw(*map, *player, *itemManager, enemyManager, currentState);
+	//draw one tick behind the simulation, blending the snapshot's tick by the leftover time
+	RenderSnapshot& snapshot = simulation.getLatestSnapshot();
+	double alpha = (simulatedTime + accumulator - snapshot.time) / FIXED_TIMESTEP;
+	snapshot.interpolate(std::clamp(alpha, 0.0, 1.0));
+	newState = canvas.draw(snapshot, currentState);
+	//sounds the simulation asked for are played here, where the audio device lives
+	AudioSystem::getInstance()->update(snapshot.player.position);
+}
+
+void Game::submitTicks()
+{
+	InputFrame input = InputFrame::sample();
+	accumulator += input.deltaTime;
+	pendingInput.accumulate(input);
+	if (replay.isPlaying()) {
+		replayFrames++;
+		if (uncapped) {
+			//one tick per frame, as fast as frames can be drawn
+			accumulator = FIXED_TIMESTEP;
+		}
+	}
+
+	int ticks = 0;
+	while (accumulator >= FIXED_TIMESTEP && ticks < MAX_TICKS_PER_FRAME) {
+		accumulator -= FIXED_TIMESTEP;
+		simulatedTime += FIXED_TIMESTEP;
+		ticks++;
+		//only the last tick of the frame needs a snapshot
+		bool last = accumulator < FIXED_TIMESTEP || ticks == MAX_TICKS_PER_FRAME;
+		simulation.submit(pendingInput, last);
+		pendingInput.clearEvents();
+	}
+	if (accumulator >= FIXED_TIMESTEP) {
+		//a long hitch, slow down instead of spiralling into more ticks per frame
+		accumulator = fmod(accumulator, FIXED_TIMESTEP);
+	}
+}
+
+void Game::saveState(std::vector<uint8_t>& buffer)
+{
+	StateWriter out(buffer);
+	SaveHeader header = { SAVE_MAGIC, SAVE_VERSION, 0 };
+	out.write(header);
+	out.write<int32_t>(map->getCurrentIndex());
+	out.write(GameClock::getInstance()->getTime());
+	map->save(out);
+	itemManager->save(out);
+	player->save(out);
+	enemyManager.save(out);
+	//the total size is only known at the end
+	uint32_t size = out.size();
+	memcpy(buffer.data() + offsetof(SaveHeader, size), &size, sizeof(size));
+}
+
+bool Game::loadState(const std::vector<uint8_t>& buffer)
+{
+	StateReader in(buffer);
+	SaveHeader header;
+	int32_t level;
+	double time;
+	if (!in.read(header) || header.magic != SAVE_MAGIC || header.version != SAVE_VERSION || header.size != buffer.size()) {
+		return false;
+	}
+	if (!in.read(level) || level < 0 || level >= map->getMapCount() || !in.read(time)) {
+		return false;
+	}
+	if (level != map->getCurrentIndex()) {
+		currentLevel = level;
+		map->setLevel(level);
+		itemManager->setLevel(level);
+		lightMap->bake(*map, *itemManager->getCurrentItemList());
+	}
+	GameClock::getInstance()->setTime(time);
+	return map->load(in) && itemManager->load(in) && player->load(in) && enemyManager.load(in);
+}
+
+void Game::quickSave()
+{
+	simulation.waitIdle();
+	saveState(saveBuffer);
+	std::ofstream file(QUICKSAVE_FILE, std::ios::binary | std::ios::trunc);
+	file.write((const char*)saveBuffer.data(), saveBuffer.size());
+}
+
+void Game::quickLoad()
+{
+	std::ifstream file(QUICKSAVE_FILE, std::ios::binary);
+	if (!file.is_open()) {
+		return;
+	}
+	saveBuffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	simulation.waitIdle();
+	//a save whose contents turn out bad can leave the game half loaded, so keep the running one
+	saveState(rollbackBuffer);
+	if (!loadState(saveBuffer)) {
+		std::cerr << "No se pudo cargar " << QUICKSAVE_FILE << ", se sigue con la partida actual" << std::endl;
+		loadState(rollbackBuffer);
+	}
+	//whatever the old state asked for (a death, a level change) no longer applies
+	simulation.takeRequestedState();
+	restartTicks();
+}
+
+void Game::restartTicks()
+{
+	simulation.waitIdle();
+	simulation.publish();
+	accumulator = 0;
+	simulatedTime = GameClock::getInstance()->getTime();
+	pendingInput = {};
+}
+
+void Game::finishReplay()
+{
+	double elapsed = GetTime() - replayStart;
+	int frames = std::max(replayFrames, 1);
+	std::cout << "Reproduccion: " << replay.getTickCount() << " ticks en " << replayFrames << " cuadros, "
+		<< elapsed << " s, " << elapsed * 1000 / frames << " ms por cuadro" << std::endl;
+	replay.stop();
+	currentState = end;
+}
+
+GameState Game::simulate(const InputFrame& frameInput)
+{
+	//the replay is read and written here so it holds exactly the ticks that were simulated
+	InputFrame input = frameInput;
+	if (replay.isPlaying() && !replay.next(input)) {
+		return end;
+	}
+	replay.record(input);
+	GameClock::getInstance()->advance(input.deltaTime);
+	player->setInput(input);
+	player->act(*map);
+	itemManager->checkForPickup();
+	enemyManager.runEnemyBehaviour(*player, *map);
+	player->weapon->update();
+	AnimationSystem::getInstance()->update(input.deltaTime);
+
+	//same precedence as the checks the main loop used to run
+	GameState state = na;
+	if (enemyManager.areEnemiesDead() || input.skipLevel) {
+		state = transition;
+	}
+	if (input.pause && player->isAlive()) {
+		state = pause;
+	}
+	if (!player->isAlive()) {
+		state = gameOver;
+	}
+	return state;
+}
+
+void Game::applySimulationState()
+{
+	GameState requested = simulation.takeRequestedState();
+	if (requested != na && currentState == playing) {
+		simulation.waitIdle();
+		currentState = requested;
+		if (requested == end) {
+			//the replay ran out of ticks
+			finishReplay();
+		}
+	}
 }
 
 void Game::logic()
@@ -84,24 +320,21 @@ void Game::logic()
 			if(IsSoundPlaying(currentSong)){
 				StopSound(currentSong);
 			}
+			if (replay.isPlaying()) {
+				currentState = playing;
+			}
 			break;
 		case playing:
+			//the simulation thread runs the level, see simulate()
 			playCurrentSong();
-			player->act(*map);
-			itemManager->checkForPickup();
-			enemyManager.runEnemyBehaviour(*player, *map);
-			if (enemyManager.areEnemiesDead() || IsKeyPressed(KEY_M)) {
-				currentState = transition;
-			}
-
-			//pausar juego si se presiona p y causar game over si jugador muere
-			if (IsKeyPressed(KEY_P) && player->isAlive()) 
-			{
-				currentState = pause;
-			}
-			if (!player->isAlive()) 
-			{
-				currentState = gameOver;
+			//loading in the middle of a recording or a replay would break it
+			if (!replay.isRecording() && !replay.isPlaying()) {
+				if (IsKeyPressed(KEY_F5)) {
+					quickSave();
+				}
+				if (IsKeyPressed(KEY_F9)) {
+					quickLoad();
+				}
 			}
 			break;
 		case pause:
@@ -111,7 +344,14 @@ void Game::logic()
 			}
 			break;
 		case gameOver:
-			if (IsKeyPressed(KEY_ENTER)) 
+			//a recording covers a single run
+			if (replay.isRecording()) {
+				replay.stop();
+			}
+			if (replay.isPlaying()) {
+				finishReplay();
+			}
+			else if (IsKeyPressed(KEY_ENTER)) 
 			{
 				currentState = mainMenu;
 			}
@@ -123,10 +363,14 @@ void Game::logic()
 			}
 			break;
 		case end:
+			simulation.stop();
 			CloseWindow();
 			break;
 		case transition:
-			if (IsKeyPressed(KEY_ENTER) && map->getCurrentIndex() < map->getMapCount() - 1) {
+			if (replay.isPlaying() && map->getCurrentIndex() == map->getMapCount() - 1) {
+				finishReplay();
+			}
+			else if ((IsKeyPressed(KEY_ENTER) || replay.isPlaying()) && map->getCurrentIndex() < map->getMapCount() - 1) {
 				nextLevel();
 				currentState = playing;
 			}
@@ -159,6 +403,7 @@ void Game::nextLevel()
 		player->reset();
 		map->setLevel(currentLevel);
 		itemManager->setLevel(currentLevel);
+		lightMap->bake(*map, *itemManager->getCurrentItemList());
 		enemyManager.initEnemies();
 	}
 }
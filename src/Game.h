@@ -1,11 +1,16 @@
 #pragma once
 #include <vector>
+#include <string>
 #include "Canvas.h"
 #include "Map.h"
 #include "RayCaster.h"
-#include "Enemy.h"
 #include "EnemyManager.h"
 #include "SoundManager.h"
+#include "LightMap.h"
+#include "InputFrame.h"
+#include "SimulationThread.h"
+#include "InputReplay.h"
+#include "SaveState.h"
 
 /**
  * @class Game
@@ -32,6 +37,60 @@ public:
      */
     GameState getState();
 
+    /**
+     * @brief Activa el escenario de prueba de carga.
+     *
+     * Cada nivel se carga con `count` enemigos repartidos por el mapa en lugar de sus
+     * enemigos normales. La horda es siempre la misma, as que sirve para medir.
+     *
+     * @param count Cantidad de enemigos, o 0 para jugar normalmente.
+     */
+    void setStressCount(int count);
+
+    /**
+     * @brief Graba la entrada de la prxima partida en un archivo.
+     *
+     * La grabacin empieza al salir del men principal y termina al perder.
+     *
+     * @param fileName Nombre del archivo.
+     */
+    void setRecording(const char* fileName);
+
+    /**
+     * @brief Reproduce una partida grabada en lugar de leer el teclado y el mouse.
+     *
+     * El juego sale del men solo, pasa de nivel solo y se cierra al terminar la
+     * grabacin, mostrando por consola cunto tard cada cuadro en promedio.
+     *
+     * @param fileName Nombre del archivo.
+     * @param uncapped Si es true se dibuja un tick por cuadro, sin lmite de cuadros por segundo.
+     * @return false si el archivo no es una grabacin vlida.
+     */
+    bool setReplay(const char* fileName, bool uncapped);
+
+    /**
+     * @brief Guarda el estado completo de la simulacin en un bfer.
+     *
+     * Incluye el nivel, el reloj, las puertas, los tems sin recoger, el jugador con su
+     * arma, los enemigos con sus animaciones, los proyectiles y el avance de las oleadas.
+     * Solo debe llamarse con la simulacin detenida (ver `SimulationThread::waitIdle`).
+     *
+     * @param buffer Bfer de destino; se reutiliza su capacidad.
+     */
+    void saveState(std::vector<uint8_t>& buffer);
+
+    /**
+     * @brief Restaura un estado guardado con `saveState`.
+     *
+     * Solo debe llamarse con la simulacin detenida. Si la cabecera coincide pero el
+     * contenido no, el juego puede quedar a medio cargar; quien llama debe restaurar un
+     * estado anterior.
+     *
+     * @param buffer Estado guardado.
+     * @return false si el bfer no es un estado vlido de esta versin.
+     */
+    bool loadState(const std::vector<uint8_t>& buffer);
+
     /**
      * @brief Construye el objeto Game e inicializa los sistemas principales.
      *
@@ -86,6 +145,60 @@ private:
      */
     void nextLevel();
 
+    /**
+     * @brief Simula un tick de juego con la entrada de un cuadro.
+     *
+     * Se ejecuta en el hilo de simulacin: mueve al jugador, revisa recolecciones,
+     * ejecuta a los enemigos y avanza todas las animaciones con `AnimationSystem`.
+     * Durante una reproduccin la entrada se reemplaza por la del prximo tick grabado;
+     * durante una grabacin se guarda la entrada de cada tick simulado.
+     *
+     * @param frameInput Entrada muestreada en el hilo principal.
+     * @return El estado al que debe pasar el juego, `end` si la reproduccin termin,
+     * o `na` si sigue en `playing`.
+     */
+    GameState simulate(const InputFrame& frameInput);
+
+    /**
+     * @brief Aplica el cambio de estado que pidi la simulacin, si lo hubo.
+     */
+    void applySimulationState();
+
+    /**
+     * @brief Encola los ticks de paso fijo que le corresponden al tiempo de este cuadro.
+     *
+     * Suma el tiempo del cuadro al acumulador y encola un tick de `FIXED_TIMESTEP` por
+     * cada paso completo, hasta `MAX_TICKS_PER_FRAME`; si el cuadro fue ms largo, el
+     * tiempo sobrante se descarta en vez de acumular un atraso que nunca se recupera.
+     */
+    void submitTicks();
+
+    /**
+     * @brief Termina la reproduccin, muestra sus tiempos y cierra el juego.
+     */
+    void finishReplay();
+
+    /**
+     * @brief Guarda la partida en `QUICKSAVE_FILE` (F5).
+     */
+    void quickSave();
+
+    /**
+     * @brief Carga la partida de `QUICKSAVE_FILE` (F9), si existe.
+     *
+     * Si el archivo no es una partida vlida lo informa por consola y el juego sigue
+     * como estaba.
+     */
+    void quickLoad();
+
+    /**
+     * @brief Vuelve a empezar la cuenta de ticks desde el estado actual de la simulacin.
+     *
+     * Se usa cuando el estado cambi de golpe (nivel nuevo o partida cargada), para no
+     * dibujar una instantnea vieja ni simular el tiempo que pas mientras tanto.
+     */
+    void restartTicks();
+
     int currentLevel;                 ///< El ndice del nivel actual.
     Sound currentSong;                ///< La msica de fondo actual que se est reproduciendo.
     Canvas canvas;                    ///< El lienzo de renderizacin para el juego.
@@ -93,7 +206,20 @@ private:
     Player* player;                   ///< Puntero a la instancia de Player.
     SoundManager* soundMgr;           ///< Puntero al singleton SoundManager.
     ItemManager* itemManager;         ///< Puntero al singleton ItemManager.
+    LightMap* lightMap;               ///< Puntero al singleton LightMap, horneado al cargar cada nivel.
     EnemyManager enemyManager;        ///< Gestiona todas las entidades enemigas en el juego.
+    SimulationThread simulation;      ///< Hilo que ejecuta la lgica mientras se dibuja el cuadro anterior.
     GameState currentState;           ///< El estado actual del juego.
+    double accumulator;               ///< Tiempo de cuadro todava no simulado, menor que un tick.
+    double simulatedTime;             ///< Tiempo de la simulacin al final del ltimo tick encolado.
+    InputFrame pendingInput;          ///< Entrada acumulada de los cuadros que an no completan un tick.
     GameState newState;               ///< El prximo estado al que se transicionar segn la lgica del juego.
+    InputReplay replay;               ///< Grabacin o reproduccin de la entrada de cada tick.
+    std::string recordFileName;       ///< Archivo donde grabar la prxima partida, o vaco.
+    int stressCount;                  ///< Enemigos del escenario de prueba de carga, o 0.
+    bool uncapped;                    ///< true si la reproduccin corre sin lmite de cuadros por segundo.
+    int replayFrames;                 ///< Cuadros dibujados durante la reproduccin.
+    double replayStart;               ///< Momento en que empez la reproduccin.
+    std::vector<uint8_t> saveBuffer;  ///< Bfer de la ltima partida guardada o cargada, reutilizado.
+    std::vector<uint8_t> rollbackBuffer; ///< Estado previo a una carga, para volver a l si la carga falla.
 };
@@ -0,0 +1,38 @@
+#include "GameClock.h"
+
+void GameClock::advance(double deltaTime)
+{
+	this->deltaTime = deltaTime;
+	time += deltaTime;
+}
+
+double GameClock::getDeltaTime()
+{
+	return deltaTime;
+}
+
+double GameClock::getTime()
+{
+	return time;
+}
+
+void GameClock::setTime(double time)
+{
+	this->time = time;
+}
+
+GameClock* GameClock::instance;
+
+GameClock* GameClock::getInstance()
+{
+	if (!instance) {
+		instance = new GameClock();
+	}
+	return instance;
+}
+
+GameClock::GameClock()
+{
+	deltaTime = 0;
+	time = 0;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#define FIXED_TIMESTEP (1.0 / 60.0)
+#define MAX_TICKS_PER_FRAME 5
+
+/**
+ * @class GameClock
+ * @brief Reloj de la simulación.
+ *
+ * La lógica del juego no lee `GetFrameTime()` directamente: cada tick de simulación
+ * avanza este reloj `FIXED_TIMESTEP` segundos, así que la simulación da el mismo
+ * resultado a cualquier tasa de cuadros y puede correr en otro hilo que el de dibujo.
+ */
+class GameClock {
+public:
+    /**
+     * @brief Avanza el reloj un tick.
+     *
+     * @param deltaTime Duración del tick en segundos.
+     */
+    void advance(double deltaTime);
+
+    /**
+     * @brief Duración del tick actual.
+     * @return Tiempo en segundos.
+     */
+    double getDeltaTime();
+
+    /**
+     * @brief Tiempo total simulado desde el inicio.
+     * @return Tiempo en segundos.
+     */
+    double getTime();
+
+    /**
+     * @brief Cambia el tiempo total simulado, por ejemplo al cargar una partida.
+     *
+     * @param time Tiempo en segundos.
+     */
+    void setTime(double time);
+
+    /**
+     * @brief Obtiene la instancia única de `GameClock`.
+     * @return Puntero a la instancia única.
+     */
+    static GameClock* getInstance();
+
+private:
+    double deltaTime;          ///< Duración del tick actual.
+    double time;               ///< Tiempo total simulado.
+    static GameClock* instance; ///< Instancia única de la clase (Singleton).
+
+    /**
+     * @brief Constructor privado; el reloj empieza en cero.
+     */
+    GameClock();
+};
@@ -0,0 +1,421 @@
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+#include "HierarchicalPathfinder.h"
+
+bool HierarchicalPathfinder::getWaypoint(Map& map, Point2D position, Point2D goal, Point2D& waypoint)
+{
+	int row = int(position.y);
+	int column = int(position.x);
+	int goalRow = int(goal.y);
+	int goalColumn = int(goal.x);
+	if (row < 0 || row >= GRID_SIZE || column < 0 || column >= GRID_SIZE
+		|| goalRow < 0 || goalRow >= GRID_SIZE || goalColumn < 0 || goalColumn >= GRID_SIZE) {
+		return false;
+	}
+	int cell = row * GRID_SIZE + column;
+	int goalCell = goalRow * GRID_SIZE + goalColumn;
+	if (cell == goalCell) {
+		return false;
+	}
+	if (!built || map.getRevision() != mapRevision) {
+		repair(map);
+	}
+
+	//anyone already standing on a path to the same goal reuses it
+	useCounter++;
+	for (auto& entry : cache) {
+		if (entry.goal != goalCell) {
+			continue;
+		}
+		auto step = std::find(entry.cells.begin(), entry.cells.end(), cell);
+		if (step != entry.cells.end() && step + 1 != entry.cells.end()) {
+			entry.lastUse = useCounter;
+			int nextCell = *(step + 1);
+			waypoint = { nextCell % GRID_SIZE + 0.5, nextCell / GRID_SIZE + 0.5 };
+			return true;
+		}
+	}
+
+	std::vector<int> path;
+	if (!findPath(map, cell, goalCell, path) || path.size() < 2) {
+		return false;
+	}
+	int nextCell = path[1];
+	if ((int)cache.size() < PATH_CACHE_SIZE) {
+		cache.push_back({ goalCell, std::move(path), useCounter });
+	}
+	else {
+		auto oldest = std::min_element(cache.begin(), cache.end(),
+			[](const CachedPath& a, const CachedPath& b) { return a.lastUse < b.lastUse; });
+		*oldest = { goalCell, std::move(path), useCounter };
+	}
+	waypoint = { nextCell % GRID_SIZE + 0.5, nextCell / GRID_SIZE + 0.5 };
+	return true;
+}
+
+bool HierarchicalPathfinder::findPath(Map& map, int start, int goal, std::vector<int>& path)
+{
+	if (!built || map.getRevision() != mapRevision) {
+		repair(map);
+	}
+	path.clear();
+	if (!walkable[start] || !walkable[goal]) {
+		return false;
+	}
+	int startCluster = clusterOf(start);
+	int goalCluster = clusterOf(goal);
+
+	//close goals are usually reachable without leaving the cluster
+	path.push_back(start);
+	if (startCluster == goalCluster && appendLocalPath(startCluster, start, goal, path)) {
+		return true;
+	}
+	path.clear();
+
+	//connect the start and the goal to the entrances of their clusters
+	startLinks.clear();
+	floodCluster(startCluster, start);
+	for (int node : clusters[startCluster].nodes) {
+		int distance = localDistance[localIndex(startCluster, node)];
+		if (distance >= 0) {
+			startLinks.push_back({ node, distance });
+		}
+	}
+	goalLinks.clear();
+	floodCluster(goalCluster, goal);
+	for (int node : clusters[goalCluster].nodes) {
+		int distance = localDistance[localIndex(goalCluster, node)];
+		if (distance >= 0) {
+			goalLinks.push_back({ node, distance });
+		}
+	}
+
+	//A* over the entrances, four-way steps make the manhattan distance admissible
+	searchId++;
+	int goalRow = goal / GRID_SIZE;
+	int goalColumn = goal % GRID_SIZE;
+	auto heuristic = [goalRow, goalColumn](int cell) {
+		return abs(cell / GRID_SIZE - goalRow) + abs(cell % GRID_SIZE - goalColumn);
+	};
+	//a binary heap over a reused vector, so the queue keeps its capacity between searches
+	std::vector<QueueEntry>& open = openQueue;
+	open.clear();
+	auto push = [&open](QueueEntry entry) {
+		open.push_back(entry);
+		std::push_heap(open.begin(), open.end(), std::greater<QueueEntry>());
+	};
+	auto relax = [&](int from, int to, int stepCost) {
+		int newCost = cost[from] + stepCost;
+		if (visited[to] != searchId || newCost < cost[to]) {
+			visited[to] = searchId;
+			cost[to] = newCost;
+			parent[to] = from;
+			push({ newCost + heuristic(to), to });
+		}
+	};
+	visited[start] = searchId;
+	cost[start] = 0;
+	parent[start] = -1;
+	push({ heuristic(start), start });
+
+	bool found = false;
+	while (!open.empty()) {
+		std::pop_heap(open.begin(), open.end(), std::greater<QueueEntry>());
+		QueueEntry top = open.back();
+		open.pop_back();
+		int current = top.second;
+		if (top.first - heuristic(current) > cost[current]) {
+			continue;
+		}
+		if (current == goal) {
+			found = true;
+			break;
+		}
+		if (current == start) {
+			for (auto& link : startLinks) {
+				relax(current, link.first, link.second);
+			}
+		}
+		int cluster = clusterOf(current);
+		Cluster& data = clusters[cluster];
+		auto node = std::find(data.nodes.begin(), data.nodes.end(), current);
+		if (node != data.nodes.end()) {
+			//other entrances of the same cluster
+			int nodeCount = data.nodes.size();
+			int i = node - data.nodes.begin();
+			for (int j = 0; j < nodeCount; j++) {
+				int stepCost = data.costs[i * nodeCount + j];
+				if (j != i && stepCost >= 0) {
+					relax(current, data.nodes[j], stepCost);
+				}
+			}
+
+			//the cell on the other side of each border
+			int clusterRow = cluster / clustersPerSide;
+			int clusterColumn = cluster % clustersPerSide;
+			for (auto& entrance : eastBorders[cluster]) {
+				if (entrance.inside == current) relax(current, entrance.outside, 1);
+			}
+			for (auto& entrance : southBorders[cluster]) {
+				if (entrance.inside == current) relax(current, entrance.outside, 1);
+			}
+			if (clusterColumn > 0) {
+				for (auto& entrance : eastBorders[cluster - 1]) {
+					if (entrance.outside == current) relax(current, entrance.inside, 1);
+				}
+			}
+			if (clusterRow > 0) {
+				for (auto& entrance : southBorders[cluster - clustersPerSide]) {
+					if (entrance.outside == current) relax(current, entrance.inside, 1);
+				}
+			}
+		}
+		if (cluster == goalCluster) {
+			for (auto& link : goalLinks) {
+				if (link.first == current) {
+					relax(current, goal, link.second);
+				}
+			}
+		}
+	}
+	if (!found) {
+		return false;
+	}
+
+	abstractPath.clear();
+	for (int cell = goal; cell >= 0; cell = parent[cell]) {
+		abstractPath.push_back(cell);
+	}
+	std::reverse(abstractPath.begin(), abstractPath.end());
+
+	//refine: steps inside a cluster are walked cell by cell, steps across a border are adjacent cells
+	path.push_back(start);
+	for (int i = 1; i < (int)abstractPath.size(); i++) {
+		int from = abstractPath[i - 1];
+		int to = abstractPath[i];
+		if (clusterOf(from) == clusterOf(to)) {
+			if (!appendLocalPath(clusterOf(from), from, to, path)) {
+				path.clear();
+				return false;
+			}
+		}
+		else {
+			path.push_back(to);
+		}
+	}
+	return true;
+}
+
+HierarchicalPathfinder::HierarchicalPathfinder()
+{
+	clustersPerSide = (GRID_SIZE + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+	int clusterCount = clustersPerSide * clustersPerSide;
+	eastBorders.resize(clusterCount);
+	southBorders.resize(clusterCount);
+	clusters.resize(clusterCount);
+	walkable.assign(GRID_SIZE * GRID_SIZE, 0);
+	built = false;
+	mapRevision = 0;
+	useCounter = 0;
+	localDistance.resize(CLUSTER_SIZE * CLUSTER_SIZE);
+	localParent.resize(CLUSTER_SIZE * CLUSTER_SIZE);
+	localQueue.reserve(CLUSTER_SIZE * CLUSTER_SIZE);
+	cost.resize(GRID_SIZE * GRID_SIZE);
+	parent.resize(GRID_SIZE * GRID_SIZE);
+	visited.assign(GRID_SIZE * GRID_SIZE, 0);
+	searchId = 0;
+}
+
+void HierarchicalPathfinder::repair(Map& map)
+{
+	int clusterCount = clustersPerSide * clustersPerSide;
+	std::vector<uint8_t> dirty(clusterCount, built ? 0 : 1);
+	for (int row = 0; row < GRID_SIZE; row++) {
+		for (int column = 0; column < GRID_SIZE; column++) {
+			int cell = row * GRID_SIZE + column;
+			uint8_t isWalkable = map.isPositionEmpty(row, column) ? 1 : 0;
+			if (walkable[cell] != isWalkable) {
+				walkable[cell] = isWalkable;
+				dirty[clusterOf(cell)] = 1;
+			}
+		}
+	}
+	built = true;
+	mapRevision = map.getRevision();
+
+	//a changed cluster changes its four borders, and with them the entrances of its neighbours
+	std::vector<uint8_t> affected(clusterCount, 0);
+	for (int cluster = 0; cluster < clusterCount; cluster++) {
+		if (!dirty[cluster]) {
+			continue;
+		}
+		int clusterRow = cluster / clustersPerSide;
+		int clusterColumn = cluster % clustersPerSide;
+		buildBorder(cluster, true);
+		buildBorder(cluster, false);
+		affected[cluster] = 1;
+		if (clusterColumn > 0) {
+			buildBorder(cluster - 1, true);
+			affected[cluster - 1] = 1;
+		}
+		if (clusterRow > 0) {
+			buildBorder(cluster - clustersPerSide, false);
+			affected[cluster - clustersPerSide] = 1;
+		}
+		if (clusterColumn < clustersPerSide - 1) {
+			affected[cluster + 1] = 1;
+		}
+		if (clusterRow < clustersPerSide - 1) {
+			affected[cluster + clustersPerSide] = 1;
+		}
+	}
+	for (int cluster = 0; cluster < clusterCount; cluster++) {
+		if (affected[cluster]) {
+			buildCluster(cluster);
+		}
+	}
+
+	//drop cached paths through the clusters that changed
+	cache.erase(std::remove_if(cache.begin(), cache.end(), [&](const CachedPath& entry) {
+		for (int cell : entry.cells) {
+			if (dirty[clusterOf(cell)]) {
+				return true;
+			}
+		}
+		return false;
+	}), cache.end());
+}
+
+void HierarchicalPathfinder::buildBorder(int cluster, bool east)
+{
+	std::vector<Entrance>& border = east ? eastBorders[cluster] : southBorders[cluster];
+	border.clear();
+	int clusterRow = cluster / clustersPerSide;
+	int clusterColumn = cluster % clustersPerSide;
+	if ((east && clusterColumn == clustersPerSide - 1) || (!east && clusterRow == clustersPerSide - 1)) {
+		return;
+	}
+
+	//one entrance in the middle of every open stretch of the border
+	int first = (east ? clusterRow : clusterColumn) * CLUSTER_SIZE;
+	int last = std::min(first + CLUSTER_SIZE, GRID_SIZE);
+	int edge = ((east ? clusterColumn : clusterRow) + 1) * CLUSTER_SIZE;
+	int runStart = -1;
+	for (int i = first; i <= last; i++) {
+		bool open = false;
+		if (i < last) {
+			int inside = east ? i * GRID_SIZE + edge - 1 : (edge - 1) * GRID_SIZE + i;
+			int outside = east ? i * GRID_SIZE + edge : edge * GRID_SIZE + i;
+			open = walkable[inside] && walkable[outside];
+		}
+		if (open && runStart < 0) {
+			runStart = i;
+		}
+		else if (!open && runStart >= 0) {
+			int middle = (runStart + i - 1) / 2;
+			if (east) {
+				border.push_back({ middle * GRID_SIZE + edge - 1, middle * GRID_SIZE + edge });
+			}
+			else {
+				border.push_back({ (edge - 1) * GRID_SIZE + middle, edge * GRID_SIZE + middle });
+			}
+			runStart = -1;
+		}
+	}
+}
+
+void HierarchicalPathfinder::buildCluster(int cluster)
+{
+	Cluster& data = clusters[cluster];
+	data.nodes.clear();
+	int clusterRow = cluster / clustersPerSide;
+	int clusterColumn = cluster % clustersPerSide;
+	for (auto& entrance : eastBorders[cluster]) {
+		data.nodes.push_back(entrance.inside);
+	}
+	for (auto& entrance : southBorders[cluster]) {
+		data.nodes.push_back(entrance.inside);
+	}
+	if (clusterColumn > 0) {
+		for (auto& entrance : eastBorders[cluster - 1]) {
+			data.nodes.push_back(entrance.outside);
+		}
+	}
+	if (clusterRow > 0) {
+		for (auto& entrance : southBorders[cluster - clustersPerSide]) {
+			data.nodes.push_back(entrance.outside);
+		}
+	}
+	std::sort(data.nodes.begin(), data.nodes.end());
+	data.nodes.erase(std::unique(data.nodes.begin(), data.nodes.end()), data.nodes.end());
+
+	int nodeCount = data.nodes.size();
+	data.costs.assign(nodeCount * nodeCount, -1);
+	for (int i = 0; i < nodeCount; i++) {
+		floodCluster(cluster, data.nodes[i]);
+		for (int j = 0; j < nodeCount; j++) {
+			data.costs[i * nodeCount + j] = localDistance[localIndex(cluster, data.nodes[j])];
+		}
+	}
+}
+
+void HierarchicalPathfinder::floodCluster(int cluster, int from)
+{
+	int firstRow = cluster / clustersPerSide * CLUSTER_SIZE;
+	int firstColumn = cluster % clustersPerSide * CLUSTER_SIZE;
+	int lastRow = std::min(firstRow + CLUSTER_SIZE, GRID_SIZE);
+	int lastColumn = std::min(firstColumn + CLUSTER_SIZE, GRID_SIZE);
+	std::fill(localDistance.begin(), localDistance.end(), -1);
+
+	localQueue.clear();
+	localQueue.push_back(from);
+	localDistance[localIndex(cluster, from)] = 0;
+	localParent[localIndex(cluster, from)] = -1;
+	const int sideRow[4] = { -1, 1, 0, 0 };
+	const int sideColumn[4] = { 0, 0, -1, 1 };
+	for (int head = 0; head < (int)localQueue.size(); head++) {
+		int current = localQueue[head];
+		int row = current / GRID_SIZE;
+		int column = current % GRID_SIZE;
+		for (int side = 0; side < 4; side++) {
+			int neighbourRow = row + sideRow[side];
+			int neighbourColumn = column + sideColumn[side];
+			if (neighbourRow < firstRow || neighbourRow >= lastRow || neighbourColumn < firstColumn || neighbourColumn >= lastColumn) {
+				continue;
+			}
+			int neighbour = neighbourRow * GRID_SIZE + neighbourColumn;
+			int local = localIndex(cluster, neighbour);
+			if (walkable[neighbour] && localDistance[local] < 0) {
+				localDistance[local] = localDistance[localIndex(cluster, current)] + 1;
+				localParent[local] = current;
+				localQueue.push_back(neighbour);
+			}
+		}
+	}
+}
+
+bool HierarchicalPathfinder::appendLocalPath(int cluster, int from, int to, std::vector<int>& path)
+{
+	//flood from the end so following the parents walks the path forwards
+	floodCluster(cluster, to);
+	if (localDistance[localIndex(cluster, from)] < 0) {
+		return false;
+	}
+	for (int cell = localParent[localIndex(cluster, from)]; cell >= 0; cell = localParent[localIndex(cluster, cell)]) {
+		path.push_back(cell);
+	}
+	return true;
+}
+
+int HierarchicalPathfinder::clusterOf(int cell) const
+{
+	return cell / GRID_SIZE / CLUSTER_SIZE * clustersPerSide + cell % GRID_SIZE / CLUSTER_SIZE;
+}
+
+int HierarchicalPathfinder::localIndex(int cluster, int cell) const
+{
+	int row = cell / GRID_SIZE - cluster / clustersPerSide * CLUSTER_SIZE;
+	int column = cell % GRID_SIZE - cluster % clustersPerSide * CLUSTER_SIZE;
+	return row * CLUSTER_SIZE + column;
+}
@@ -0,0 +1,165 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include "Point2D.h"
+#include "Map.h"
+#define CLUSTER_SIZE 10
+#define PATH_CACHE_SIZE 16
+
+/**
+ * @class HierarchicalPathfinder
+ * @brief Buscador de caminos entre dos celdas cualesquiera, para objetivos que no son el jugador.
+ *
+ * El mapa se divide en grupos de `CLUSTER_SIZE x CLUSTER_SIZE` celdas. Cada tramo
+ * transitable del borde entre dos grupos vecinos aporta una entrada, y dentro de cada
+ * grupo se guarda el costo entre todas sus entradas. Un camino se busca primero con A*
+ * sobre ese grafo abstracto, que tiene unas pocas entradas por grupo en vez de todas las
+ * celdas, y después se refina celda por celda solo dentro de los grupos que atraviesa.
+ *
+ * Los últimos `PATH_CACHE_SIZE` caminos se guardan: quien ya está sobre un camino hacia el
+ * mismo destino lo reutiliza sin buscar. Cuando cambia la revisión del mapa solo se
+ * recalculan los grupos cuyas celdas cambiaron (y sus vecinos), y se descartan los caminos
+ * guardados que pasan por ellos.
+ */
+class HierarchicalPathfinder {
+public:
+    /**
+     * @brief Obtiene el próximo punto del camino desde una posición hasta un destino.
+     *
+     * @param map Mapa del nivel actual.
+     * @param position Posición actual.
+     * @param goal Destino.
+     * @param waypoint Centro de la siguiente celda del camino.
+     * @return false si no hay camino o la posición ya está en la celda del destino.
+     */
+    bool getWaypoint(Map& map, Point2D position, Point2D goal, Point2D& waypoint);
+
+    /**
+     * @brief Busca un camino entre dos celdas, sin usar los caminos guardados.
+     *
+     * @param map Mapa del nivel actual.
+     * @param start Celda de inicio (`fila * GRID_SIZE + columna`).
+     * @param goal Celda de destino.
+     * @param path Celdas del camino, incluyendo el inicio y el destino.
+     * @return false si no hay camino.
+     */
+    bool findPath(Map& map, int start, int goal, std::vector<int>& path);
+
+    /**
+     * @brief Reserva las estructuras; el grafo se construye en la primera búsqueda.
+     */
+    HierarchicalPathfinder();
+
+private:
+    /**
+     * @struct Entrance
+     * @brief Par de celdas vecinas a cada lado del borde entre dos grupos.
+     */
+    struct Entrance {
+        int inside;  ///< Celda del grupo al oeste o al norte.
+        int outside; ///< Celda del grupo al este o al sur.
+    };
+
+    /**
+     * @struct Cluster
+     * @brief Entradas de un grupo y el costo entre cada par de ellas.
+     */
+    struct Cluster {
+        std::vector<int> nodes; ///< Celdas de entrada del grupo.
+        std::vector<int> costs; ///< Pasos entre las entradas `i` y `j` en `i * nodes.size() + j`, o -1.
+    };
+
+    /**
+     * @struct CachedPath
+     * @brief Camino guardado para reutilizar.
+     */
+    struct CachedPath {
+        int goal;               ///< Celda de destino.
+        std::vector<int> cells; ///< Celdas del camino.
+        unsigned int lastUse;   ///< Momento del último uso, para descartar el más viejo.
+    };
+
+    typedef std::pair<int, int> QueueEntry; ///< Costo estimado y celda de una entrada de la cola del A*.
+
+    int clustersPerSide;                          ///< Grupos por lado del mapa.
+    std::vector<std::vector<Entrance>> eastBorders;  ///< Entradas entre cada grupo y su vecino al este.
+    std::vector<std::vector<Entrance>> southBorders; ///< Entradas entre cada grupo y su vecino al sur.
+    std::vector<Cluster> clusters;                ///< Grafo abstracto de cada grupo.
+    std::vector<uint8_t> walkable;                ///< Copia de las celdas transitables usada para el grafo.
+    bool built;                                   ///< false hasta la primera construcción.
+    unsigned int mapRevision;                     ///< Revisión del mapa con la que se construyó el grafo.
+    std::vector<CachedPath> cache;                ///< Caminos guardados.
+    unsigned int useCounter;                      ///< Contador de usos del caché.
+    std::vector<int> localDistance;               ///< Distancias del último recorrido dentro de un grupo.
+    std::vector<int> localParent;                 ///< Celda anterior de cada celda en ese recorrido.
+    std::vector<int> localQueue;                  ///< Cola del recorrido dentro de un grupo.
+    std::vector<int> cost;                        ///< Costo conocido de cada celda en el A* abstracto.
+    std::vector<int> parent;                      ///< Celda anterior de cada celda en el A* abstracto.
+    std::vector<unsigned int> visited;            ///< Búsqueda en la que se tocó cada celda.
+    unsigned int searchId;                        ///< Número de la búsqueda actual.
+    std::vector<std::pair<int, int>> startLinks;  ///< Entradas alcanzables desde el inicio de la búsqueda y su distancia.
+    std::vector<std::pair<int, int>> goalLinks;   ///< Entradas desde las que se alcanza el destino y su distancia.
+    std::vector<QueueEntry> openQueue;            ///< Montículo de (costo estimado, celda) del A* abstracto.
+    std::vector<int> abstractPath;                ///< Entradas del último camino abstracto encontrado.
+
+    /**
+     * @brief Actualiza la copia del mapa y recalcula los grupos que cambiaron.
+     *
+     * @param map Mapa del nivel actual.
+     */
+    void repair(Map& map);
+
+    /**
+     * @brief Recalcula las entradas del borde este o sur de un grupo.
+     *
+     * @param cluster Índice del grupo.
+     * @param east true para el borde este, false para el sur.
+     */
+    void buildBorder(int cluster, bool east);
+
+    /**
+     * @brief Recalcula las entradas de un grupo y el costo entre ellas.
+     *
+     * @param cluster Índice del grupo.
+     */
+    void buildCluster(int cluster);
+
+    /**
+     * @brief Recorre en anchura un grupo desde una de sus celdas.
+     *
+     * Deja el resultado en `localDistance` y `localParent`, indexados con `localIndex`.
+     *
+     * @param cluster Índice del grupo.
+     * @param from Celda de inicio.
+     */
+    void floodCluster(int cluster, int from);
+
+    /**
+     * @brief Agrega al camino las celdas entre dos celdas del mismo grupo.
+     *
+     * @param cluster Índice del grupo.
+     * @param from Celda de inicio, que no se agrega.
+     * @param to Celda final, que sí se agrega.
+     * @param path Camino al que se agregan las celdas.
+     * @return false si no hay camino dentro del grupo.
+     */
+    bool appendLocalPath(int cluster, int from, int to, std::vector<int>& path);
+
+    /**
+     * @brief Grupo que contiene una celda.
+     *
+     * @param cell Celda del mapa.
+     * @return Índice del grupo.
+     */
+    int clusterOf(int cell) const;
+
+    /**
+     * @brief Índice de una celda dentro de los arreglos locales de su grupo.
+     *
+     * @param cluster Índice del grupo.
+     * @param cell Celda del mapa, dentro del grupo.
+     * @return Índice entre 0 y `CLUSTER_SIZE * CLUSTER_SIZE - 1`.
+     */
+    int localIndex(int cluster, int cell) const;
+};
@@ -0,0 +1,166 @@
+#include <cmath>
+#include <string>
+#include <sstream>
+#include <raylib.h>
+#include "HordeSpawner.h"
+#include "FileReader.h"
+
+void HordeSpawner::load(int level)
+{
+	waves.clear();
+	elapsed = 0;
+	random.seed(seed);
+	std::string path = "assets/data/waves" + std::to_string(level) + ".wave";
+	//levels without a wave file only have the enemies at their lamps
+	if (!isStress() && FileExists(path.c_str())) {
+		FileReader::readWavesFromFile(path.c_str(), waves);
+	}
+}
+
+void HordeSpawner::update(double deltaTime, Map& map, Point2D player, EnemyStore& enemies)
+{
+	elapsed += deltaTime;
+	for (SpawnWave& wave : waves) {
+		if (wave.spawned >= wave.count || elapsed < wave.startTime) {
+			continue;
+		}
+		//how many should exist by now at the wave's rate, a rate of 0 drops them all at once
+		int due = wave.count;
+		if (wave.rate > 0) {
+			due = std::min(wave.count, 1 + (int)((elapsed - wave.startTime) * wave.rate));
+		}
+		while (wave.spawned < due) {
+			Point2D position;
+			if (pickPosition(wave, map, player, position)) {
+				enemies.spawn(pickType(wave.meleeWeight, wave.rangeWeight), position);
+			}
+			//a spot that can't be found is skipped, the wave still ends
+			wave.spawned++;
+		}
+	}
+}
+
+void HordeSpawner::spawnStress(const FlowField& field, EnemyStore& enemies)
+{
+	std::vector<int> cells;
+	for (int row = 0; row < GRID_SIZE; row++) {
+		for (int column = 0; column < GRID_SIZE; column++) {
+			if (field.getDistance(row, column) >= STRESS_MIN_STEPS) {
+				cells.push_back(row * GRID_SIZE + column);
+			}
+		}
+	}
+	if (cells.empty()) {
+		return;
+	}
+	std::uniform_int_distribution<int> pickCell(0, cells.size() - 1);
+	std::uniform_real_distribution<double> offset(0.2, 0.8);
+	for (int i = 0; i < stressCount; i++) {
+		int cell = cells[pickCell(random)];
+		Point2D position = { cell % GRID_SIZE + offset(random), cell / GRID_SIZE + offset(random) };
+		enemies.spawn(pickType(1, 1), position);
+	}
+}
+
+bool HordeSpawner::isFinished() const
+{
+	for (const SpawnWave& wave : waves) {
+		if (wave.spawned < wave.count) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool HordeSpawner::isStress() const
+{
+	return stressCount > 0;
+}
+
+void HordeSpawner::setStressCount(int count)
+{
+	stressCount = count;
+}
+
+void HordeSpawner::setSeed(unsigned int seed)
+{
+	this->seed = seed;
+}
+
+unsigned int HordeSpawner::getSeed() const
+{
+	return seed;
+}
+
+HordeSpawner::HordeSpawner()
+{
+	elapsed = 0;
+	stressCount = 0;
+	seed = SPAWN_SEED;
+	random.seed(seed);
+}
+
+EnemyType HordeSpawner::pickType(int meleeWeight, int rangeWeight)
+{
+	int total = meleeWeight + rangeWeight;
+	if (total <= 0) {
+		return melee;
+	}
+	std::uniform_int_distribution<int> pick(0, total - 1);
+	return pick(random) < meleeWeight ? melee : range;
+}
+
+void HordeSpawner::save(StateWriter& out)
+{
+	out.write(elapsed);
+	out.write<int32_t>(waves.size());
+	for (const SpawnWave& wave : waves) {
+		out.write<int32_t>(wave.spawned);
+	}
+	//the engine's own text form, its memory layout belongs to the standard library
+	std::ostringstream engine;
+	engine << random;
+	std::string text = engine.str();
+	out.write<int32_t>(text.size());
+	out.writeBlock(text.data(), text.size());
+}
+
+bool HordeSpawner::load(StateReader& in)
+{
+	int32_t count;
+	if (!in.read(elapsed) || !in.read(count) || count != (int)waves.size()) {
+		return false;
+	}
+	for (SpawnWave& wave : waves) {
+		int32_t spawned;
+		if (!in.read(spawned)) {
+			return false;
+		}
+		wave.spawned = spawned;
+	}
+	std::vector<char> text;
+	if (!in.readArray(text)) {
+		return false;
+	}
+	std::istringstream engine(std::string(text.begin(), text.end()));
+	engine >> random;
+	return !engine.fail();
+}
+
+bool HordeSpawner::pickPosition(const SpawnWave& wave, Map& map, Point2D player, Point2D& position)
+{
+	std::uniform_real_distribution<double> unit(0, 1);
+	for (int attempt = 0; attempt < SPAWN_ATTEMPTS; attempt++) {
+		//sqrt keeps the points uniform over the circle instead of bunched at its centre
+		double distance = wave.radius * sqrt(unit(random));
+		double angle = unit(random) * 2 * PI;
+		position = { wave.zone.x + cos(angle) * distance, wave.zone.y + sin(angle) * distance };
+		double dx = position.x - player.x;
+		double dy = position.y - player.y;
+		if (map.isPositionEmpty(int(position.y), int(position.x)) &&
+			dx * dx + dy * dy >= SPAWN_MIN_PLAYER_DISTANCE * SPAWN_MIN_PLAYER_DISTANCE) {
+			return true;
+		}
+	}
+	return false;
+}
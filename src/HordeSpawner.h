@@ -0,0 +1,150 @@
+#pragma once
+#include <vector>
+#include <random>
+#include "Point2D.h"
+#include "Map.h"
+#include "EnemyStore.h"
+#include "FlowField.h"
+#include "SaveState.h"
+#define SPAWN_SEED 1234
+#define SPAWN_ATTEMPTS 16
+#define SPAWN_MIN_PLAYER_DISTANCE 3.0
+#define STRESS_MIN_STEPS 6
+
+/**
+ * @struct SpawnWave
+ * @brief Oleada de enemigos leída de un archivo `.wave`.
+ */
+struct SpawnWave {
+    double startTime;  ///< Segundos desde el inicio del nivel hasta que empieza.
+    int count;         ///< Cantidad de enemigos de la oleada.
+    double rate;       ///< Enemigos por segundo; 0 los crea a todos juntos.
+    int meleeWeight;   ///< Peso de `melee` en la mezcla de tipos.
+    int rangeWeight;   ///< Peso de `range` en la mezcla de tipos.
+    Point2D zone;      ///< Centro de la zona de aparición.
+    double radius;     ///< Radio de la zona de aparición.
+    int spawned;       ///< Enemigos ya creados.
+};
+
+/**
+ * @class HordeSpawner
+ * @brief Crea enemigos por oleadas durante el nivel.
+ *
+ * Las oleadas de cada nivel se leen de `assets/data/wavesN.wave`, si existe. Cada una
+ * empieza a un tiempo dado y crea sus enemigos a un ritmo fijo, en puntos al azar de su
+ * zona que sean transitables y no estén encima del jugador. También puede armar un
+ * escenario de prueba de carga con una cantidad fija de enemigos repartidos por todo
+ * el nivel. El generador de números al azar se reinicia con la misma semilla en cada
+ * nivel, así que el mismo nivel produce siempre la misma horda.
+ */
+class HordeSpawner {
+public:
+    /**
+     * @brief Carga las oleadas de un nivel y reinicia el reloj.
+     *
+     * @param level Índice del nivel.
+     */
+    void load(int level);
+
+    /**
+     * @brief Crea los enemigos que tocan en este tick.
+     *
+     * @param deltaTime Duración del tick en segundos.
+     * @param map Mapa del nivel actual.
+     * @param player Posición del jugador.
+     * @param enemies Almacén donde se crean los enemigos.
+     */
+    void update(double deltaTime, Map& map, Point2D player, EnemyStore& enemies);
+
+    /**
+     * @brief Reparte `stressCount` enemigos por las celdas alcanzables del nivel.
+     *
+     * Se saltean las celdas a menos de `STRESS_MIN_STEPS` pasos del jugador.
+     *
+     * @param field Campo de caminos apuntado al jugador.
+     * @param enemies Almacén donde se crean los enemigos.
+     */
+    void spawnStress(const FlowField& field, EnemyStore& enemies);
+
+    /**
+     * @brief Verifica si ya se crearon todos los enemigos de todas las oleadas.
+     * @return true si no queda ninguno por crear.
+     */
+    bool isFinished() const;
+
+    /**
+     * @brief Indica si se está corriendo el escenario de prueba de carga.
+     * @return true si `stressCount` es mayor que 0.
+     */
+    bool isStress() const;
+
+    /**
+     * @brief Activa el escenario de prueba de carga en lugar de los enemigos del nivel.
+     *
+     * @param count Cantidad de enemigos, o 0 para jugar normalmente.
+     */
+    void setStressCount(int count);
+
+    /**
+     * @brief Cambia la semilla con la que se reinicia el generador en cada nivel.
+     *
+     * @param seed Semilla nueva; se usa a partir del próximo `load`.
+     */
+    void setSeed(unsigned int seed);
+
+    /**
+     * @brief Obtiene la semilla del generador.
+     * @return Semilla con la que se reinicia en cada nivel.
+     */
+    unsigned int getSeed() const;
+
+    /**
+     * @brief Elige un tipo de enemigo al azar según una mezcla.
+     *
+     * @param meleeWeight Peso de `melee`.
+     * @param rangeWeight Peso de `range`.
+     * @return Tipo elegido.
+     */
+    EnemyType pickType(int meleeWeight, int rangeWeight);
+
+    /**
+     * @brief Guarda el reloj, el avance de cada oleada y el generador al azar.
+     *
+     * El generador se guarda con su `operator<<`, no con su representación en memoria,
+     * que depende de la biblioteca estándar.
+     *
+     * @param out Destino.
+     */
+    void save(StateWriter& out);
+
+    /**
+     * @brief Restaura lo que guardó `save` sobre las oleadas ya cargadas del nivel.
+     *
+     * @param in Origen.
+     * @return false si faltaban datos o las oleadas no coinciden.
+     */
+    bool load(StateReader& in);
+
+    /**
+     * @brief Construye el generador sin oleadas.
+     */
+    HordeSpawner();
+
+private:
+    std::vector<SpawnWave> waves; ///< Oleadas del nivel actual.
+    double elapsed;               ///< Segundos desde que se cargó el nivel.
+    int stressCount;              ///< Enemigos del escenario de prueba de carga.
+    unsigned int seed;            ///< Semilla con la que se reinicia `random` en cada nivel.
+    std::mt19937 random;          ///< Generador de números al azar.
+
+    /**
+     * @brief Busca un punto transitable de la zona de una oleada.
+     *
+     * @param wave Oleada.
+     * @param map Mapa del nivel actual.
+     * @param player Posición del jugador.
+     * @param position Recibe el punto encontrado.
+     * @return false si ninguno de los `SPAWN_ATTEMPTS` intentos sirvió.
+     */
+    bool pickPosition(const SpawnWave& wave, Map& map, Point2D player, Point2D& position);
+};
@@ -0,0 +1,44 @@
+#include <raylib.h>
+#include "InputFrame.h"
+#include "GameClock.h"
+
+InputFrame InputFrame::sample()
+{
+	InputFrame input = {};
+	input.deltaTime = GetFrameTime();
+	input.mouseDeltaX = GetMouseDelta().x;
+	input.moveForward = IsKeyDown(KEY_W);
+	input.moveBackward = IsKeyDown(KEY_S);
+	input.strafeLeft = IsKeyDown(KEY_A);
+	input.strafeRight = IsKeyDown(KEY_D);
+	input.use = IsKeyPressed(KEY_SPACE);
+	input.fire = IsMouseButtonDown(MOUSE_BUTTON_LEFT);
+	input.pause = IsKeyPressed(KEY_P);
+	input.skipLevel = IsKeyPressed(KEY_M);
+	return input;
+}
+
+void InputFrame::accumulate(const InputFrame& next)
+{
+	//the player turns sensibility * deltaTime * mouseDeltaX, keep that product for a fixed tick
+	mouseDeltaX += next.mouseDeltaX * next.deltaTime / FIXED_TIMESTEP;
+	deltaTime = FIXED_TIMESTEP;
+	moveForward = next.moveForward;
+	moveBackward = next.moveBackward;
+	strafeLeft = next.strafeLeft;
+	strafeRight = next.strafeRight;
+	//a click shorter than a tick still fires once
+	fire = fire || next.fire;
+	use = use || next.use;
+	pause = pause || next.pause;
+	skipLevel = skipLevel || next.skipLevel;
+}
+
+void InputFrame::clearEvents()
+{
+	mouseDeltaX = 0;
+	fire = false;
+	use = false;
+	pause = false;
+	skipLevel = false;
+}
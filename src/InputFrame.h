@@ -0,0 +1,48 @@
+#pragma once
+
+/**
+ * @struct InputFrame
+ * @brief Entrada del jugador muestreada en un cuadro.
+ *
+ * raylib solo actualiza el teclado y el mouse en el hilo principal, así que la entrada
+ * se muestrea allí una vez por cuadro y se entrega a la simulación a través de una cola.
+ */
+struct InputFrame {
+    double deltaTime;   ///< Tiempo del cuadro en el que se muestreó, o del tick si ya se acumuló, en segundos.
+    float mouseDeltaX;  ///< Desplazamiento horizontal del mouse.
+    bool moveForward;   ///< W presionada.
+    bool moveBackward;  ///< S presionada.
+    bool strafeLeft;    ///< A presionada.
+    bool strafeRight;   ///< D presionada.
+    bool use;           ///< Espacio presionado en este cuadro (abrir puertas).
+    bool fire;          ///< Botón izquierdo del mouse presionado.
+    bool pause;         ///< P presionada en este cuadro.
+    bool skipLevel;     ///< M presionada en este cuadro.
+
+    /**
+     * @brief Muestrea el teclado, el mouse y el tiempo del cuadro actual.
+     *
+     * Debe llamarse desde el hilo principal.
+     * @return La entrada del cuadro.
+     */
+    static InputFrame sample();
+
+    /**
+     * @brief Suma la entrada de un cuadro posterior a esta.
+     *
+     * Se usa cuando un cuadro no alcanza a completar un tick: las teclas mantenidas
+     * toman el valor más reciente, las pulsaciones de un cuadro no se pierden y el
+     * movimiento del mouse se escala para que el giro no dependa de la tasa de cuadros.
+     *
+     * @param next Entrada del cuadro siguiente.
+     */
+    void accumulate(const InputFrame& next);
+
+    /**
+     * @brief Limpia las pulsaciones de un cuadro y el movimiento del mouse.
+     *
+     * Se llama después del primer tick de un cuadro para que los ticks siguientes
+     * no repitan las mismas acciones.
+     */
+    void clearEvents();
+};
@@ -0,0 +1,131 @@
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include "InputReplay.h"
+#include "GameClock.h"
+
+//bits of the key byte of each tick
+#define REPLAY_FORWARD 1
+#define REPLAY_BACKWARD 2
+#define REPLAY_LEFT 4
+#define REPLAY_RIGHT 8
+#define REPLAY_USE 16
+#define REPLAY_FIRE 32
+#define REPLAY_SKIP_LEVEL 64
+#define REPLAY_TICK_SIZE (sizeof(float) + 1)
+
+bool InputReplay::startRecording(const char* fileName, const ReplayHeader& header)
+{
+	stop();
+	output.open(fileName, std::ios::binary | std::ios::trunc);
+	if (!output.is_open()) {
+		std::cerr << "No se pudo crear la grabación: " << fileName << std::endl;
+		return false;
+	}
+	this->header = header;
+	this->header.magic = REPLAY_MAGIC;
+	this->header.version = REPLAY_VERSION;
+	output.write((const char*)&this->header, sizeof(ReplayHeader));
+	recording = true;
+	return true;
+}
+
+void InputReplay::record(const InputFrame& input)
+{
+	if (!recording) {
+		return;
+	}
+	uint8_t keys = 0;
+	keys |= input.moveForward ? REPLAY_FORWARD : 0;
+	keys |= input.moveBackward ? REPLAY_BACKWARD : 0;
+	keys |= input.strafeLeft ? REPLAY_LEFT : 0;
+	keys |= input.strafeRight ? REPLAY_RIGHT : 0;
+	keys |= input.use ? REPLAY_USE : 0;
+	keys |= input.fire ? REPLAY_FIRE : 0;
+	keys |= input.skipLevel ? REPLAY_SKIP_LEVEL : 0;
+	output.write((const char*)&input.mouseDeltaX, sizeof(float));
+	output.write((const char*)&keys, 1);
+	ticks++;
+}
+
+bool InputReplay::startPlayback(const char* fileName)
+{
+	stop();
+	std::ifstream file(fileName, std::ios::binary);
+	if (!file.is_open()) {
+		std::cerr << "No se pudo abrir la grabación: " << fileName << std::endl;
+		return false;
+	}
+	file.read((char*)&header, sizeof(ReplayHeader));
+	if (!file || header.magic != REPLAY_MAGIC || header.version != REPLAY_VERSION) {
+		std::cerr << "El archivo no es una grabación válida: " << fileName << std::endl;
+		return false;
+	}
+	//read it all up front so playback never waits on the disk
+	playback.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	cursor = 0;
+	playing = true;
+	return true;
+}
+
+bool InputReplay::next(InputFrame& input)
+{
+	if (!playing || cursor + REPLAY_TICK_SIZE > playback.size()) {
+		return false;
+	}
+	input = {};
+	input.deltaTime = FIXED_TIMESTEP;
+	memcpy(&input.mouseDeltaX, &playback[cursor], sizeof(float));
+	uint8_t keys = playback[cursor + sizeof(float)];
+	cursor += REPLAY_TICK_SIZE;
+	input.moveForward = keys & REPLAY_FORWARD;
+	input.moveBackward = keys & REPLAY_BACKWARD;
+	input.strafeLeft = keys & REPLAY_LEFT;
+	input.strafeRight = keys & REPLAY_RIGHT;
+	input.use = keys & REPLAY_USE;
+	input.fire = keys & REPLAY_FIRE;
+	input.skipLevel = keys & REPLAY_SKIP_LEVEL;
+	ticks++;
+	return true;
+}
+
+void InputReplay::stop()
+{
+	if (recording) {
+		output.close();
+	}
+	playback.clear();
+	cursor = 0;
+	recording = false;
+	playing = false;
+	ticks = 0;
+}
+
+bool InputReplay::isRecording() const
+{
+	return recording;
+}
+
+bool InputReplay::isPlaying() const
+{
+	return playing;
+}
+
+const ReplayHeader& InputReplay::getHeader() const
+{
+	return header;
+}
+
+int InputReplay::getTickCount() const
+{
+	return ticks;
+}
+
+InputReplay::InputReplay()
+{
+	header = {};
+	cursor = 0;
+	recording = false;
+	playing = false;
+	ticks = 0;
+}
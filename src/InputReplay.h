@@ -0,0 +1,106 @@
+#pragma once
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include "InputFrame.h"
+#define REPLAY_MAGIC 0x594C5052
+#define REPLAY_VERSION 1
+
+/**
+ * @struct ReplayHeader
+ * @brief Datos de la partida grabada que no salen de la entrada.
+ */
+struct ReplayHeader {
+    uint32_t magic;       ///< `REPLAY_MAGIC`, para reconocer el archivo.
+    uint32_t version;     ///< `REPLAY_VERSION` con la que se grabó.
+    uint32_t seed;        ///< Semilla de las decisiones al azar de los enemigos.
+    int32_t stressCount;  ///< Enemigos del escenario de prueba de carga, o 0.
+    double sensibility;   ///< Sensibilidad del mouse del jugador.
+};
+
+/**
+ * @class InputReplay
+ * @brief Graba la entrada de cada tick en un archivo y la vuelve a entregar.
+ *
+ * Como la simulación avanza con ticks fijos y solo depende de la entrada y de la semilla,
+ * la misma grabación produce siempre la misma partida, sin importar la velocidad a la
+ * que se reproduzca. Cada tick ocupa 5 bytes: el movimiento del mouse y un byte con las
+ * teclas. La pausa no se graba porque no cambia la simulación.
+ */
+class InputReplay {
+public:
+    /**
+     * @brief Empieza a grabar en un archivo, reemplazándolo si existe.
+     *
+     * @param fileName Nombre del archivo.
+     * @param header Datos de la partida.
+     * @return false si no se pudo crear el archivo.
+     */
+    bool startRecording(const char* fileName, const ReplayHeader& header);
+
+    /**
+     * @brief Graba la entrada de un tick.
+     *
+     * @param input Entrada que recibe la simulación en el tick.
+     */
+    void record(const InputFrame& input);
+
+    /**
+     * @brief Carga una grabación completa en memoria para reproducirla.
+     *
+     * @param fileName Nombre del archivo.
+     * @return false si el archivo no existe o no es una grabación de esta versión.
+     */
+    bool startPlayback(const char* fileName);
+
+    /**
+     * @brief Obtiene la entrada del próximo tick grabado.
+     *
+     * @param input Recibe la entrada, con `deltaTime` igual a `FIXED_TIMESTEP`.
+     * @return false si la grabación terminó.
+     */
+    bool next(InputFrame& input);
+
+    /**
+     * @brief Termina la grabación o la reproducción en curso.
+     */
+    void stop();
+
+    /**
+     * @brief Indica si se está grabando.
+     * @return true entre `startRecording` y `stop`.
+     */
+    bool isRecording() const;
+
+    /**
+     * @brief Indica si se está reproduciendo.
+     * @return true entre `startPlayback` y `stop`.
+     */
+    bool isPlaying() const;
+
+    /**
+     * @brief Obtiene los datos de la partida grabada o en reproducción.
+     * @return Cabecera del archivo.
+     */
+    const ReplayHeader& getHeader() const;
+
+    /**
+     * @brief Cantidad de ticks grabados o reproducidos hasta ahora.
+     * @return Número de ticks.
+     */
+    int getTickCount() const;
+
+    /**
+     * @brief Construye el objeto sin grabar ni reproducir.
+     */
+    InputReplay();
+
+private:
+    std::ofstream output;          ///< Archivo de la grabación en curso.
+    std::vector<uint8_t> playback; ///< Ticks de la grabación en reproducción.
+    size_t cursor;                 ///< Posición del próximo tick en `playback`.
+    ReplayHeader header;           ///< Datos de la partida.
+    bool recording;                ///< true mientras se graba.
+    bool playing;                  ///< true mientras se reproduce.
+    int ticks;                     ///< Ticks grabados o reproducidos.
+};
@@ -32,41 +32,45 @@ void ItemManager::initItems()
 
 	currentLevel = 0;
 	currentItems = itemLists[currentLevel];
+	rebuildGrid();
 }
 
 void ItemManager::clearItems()
 {
     currentItems.clear();
+    itemGrid.clear();
 }
 
 void ItemManager::checkForPickup()
 {
-    double dist = 0;
-    int counter = 0;
-	for (auto it = currentItems.begin(); it != currentItems.end();) {
-		auto obj = *it;
-		dist = obj->sprite->getDistanceFromPlayer(obj->position, *Player::getInstance());
-		if (dist < 0.5) {
-			auto ammoPtr = dynamic_cast<AmmoBox*>(obj);
-			auto healthPtr = dynamic_cast<HealthBox*>(obj);
+	nearby.clear();
+	itemGrid.queryRadius(Player::getInstance()->position, PICKUP_RADIUS, nearby);
+	if (nearby.empty()) {
+		return;
+	}
+	//erase from the back so the remaining indices stay valid
+	std::sort(nearby.begin(), nearby.end(), [](int a, int b) { return a > b; });
+	bool removed = false;
+	for (int index : nearby) {
+		auto obj = currentItems[index];
+		auto ammoPtr = dynamic_cast<AmmoBox*>(obj);
+		auto healthPtr = dynamic_cast<HealthBox*>(obj);
 
-			if (ammoPtr) {
-				if (ammoPtr->pickup()) {
-					delete ammoPtr->sprite;
-					delete ammoPtr;
-					it = currentItems.erase(it); 
-					continue; 
-				}
-			} else if (healthPtr) {
-				if (healthPtr->pickup()) {
-					delete healthPtr->sprite;
-					delete healthPtr;
-					it = currentItems.erase(it); 
-					continue; 
-				}
+		//picked items stay in itemLists, a loaded game may bring them back
+		if (ammoPtr) {
+			if (ammoPtr->pickup()) {
+				currentItems.erase(currentItems.begin() + index);
+				removed = true;
+			}
+		} else if (healthPtr) {
+			if (healthPtr->pickup()) {
+				currentItems.erase(currentItems.begin() + index);
+				removed = true;
 			}
 		}
-		++it; 
+	}
+	if (removed) {
+		rebuildGrid();
 	}
 }
 
@@ -80,9 +84,43 @@ void ItemManager::setLevel(int level)
 	if (level < itemLists.size()) {
 		currentLevel = level;
 		currentItems = itemLists[currentLevel];
+		rebuildGrid();
+	}
+}
+
+void ItemManager::save(StateWriter& out)
+{
+	//items are stored as their position in the level's list
+	const std::vector<Item*>& level = itemLists[currentLevel];
+	out.write<int32_t>(currentItems.size());
+	int index = 0;
+	for (Item* item : currentItems) {
+		while (level[index] != item) {
+			index++;
+		}
+		out.write<int16_t>(index);
 	}
 }
 
+bool ItemManager::load(StateReader& in)
+{
+	const std::vector<Item*>& level = itemLists[currentLevel];
+	int32_t count;
+	if (!in.read(count) || count < 0 || count > (int)level.size()) {
+		return false;
+	}
+	currentItems.clear();
+	for (int i = 0; i < count; i++) {
+		int16_t index;
+		if (!in.read(index) || index < 0 || index >= (int)level.size()) {
+			return false;
+		}
+		currentItems.push_back(level[index]);
+	}
+	rebuildGrid();
+	return true;
+}
+
 ItemManager* ItemManager::instance;
 
 ItemManager* ItemManager::getInstance()
@@ -98,4 +136,13 @@ ItemManager::ItemManager()
 	currentLevel = 0;
 	initItems();
 	currentItems = itemLists[currentLevel];
+	rebuildGrid();
+}
+
+void ItemManager::rebuildGrid()
+{
+	itemGrid.clear();
+	for (int i = 0; i < (int)currentItems.size(); i++) {
+		itemGrid.insert(i, currentItems[i]->position);
+	}
 }
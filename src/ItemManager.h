@@ -2,6 +2,9 @@
 #include <vector>
 #include "Item.h"
 #include "FileReader.h"
+#include "SpatialGrid.h"
+#include "SaveState.h"
+#define PICKUP_RADIUS 0.5
 
 /**
  * @class ItemManager
@@ -38,8 +41,8 @@ public:
     /**
      * @brief Verifica si algn tem est siendo recogido por el jugador.
      *
-     * Recorre la lista actual de tems y comprueba si estn lo suficientemente cerca
-     * del jugador para ser recogidos. Si el jugador recoge un tem, este se elimina de
+     * Busca en `itemGrid` los tems lo suficientemente cerca del jugador para ser
+     * recogidos. Si el jugador recoge un tem, este se elimina de
      * la lista y su memoria se libera.
      */
     void checkForPickup();
@@ -61,6 +64,21 @@ public:
      */
     void setLevel(int level);
 
+    /**
+     * @brief Guarda qu tems del nivel actual siguen sin recoger.
+     *
+     * @param out Destino.
+     */
+    void save(StateWriter& out);
+
+    /**
+     * @brief Restaura los tems sin recoger que guard `save`.
+     *
+     * @param in Origen.
+     * @return false si faltaban datos o no corresponden al nivel actual.
+     */
+    bool load(StateReader& in);
+
     /**
      * @brief Obtiene la instancia nica de `ItemManager`.
      *
@@ -75,6 +93,8 @@ private:
     int currentLevel; ///< ndice del nivel actual.
     std::vector<std::vector<Item*>> itemLists; ///< Listas de tems organizadas por niveles.
     std::vector<Item*> currentItems; ///< Lista de tems activos en el nivel actual.
+    SpatialGrid itemGrid; ///< ndice espacial de `currentItems`, por posicin en la lista.
+    std::vector<int> nearby; ///< Resultados de las consultas a `itemGrid`, reutilizados.
     static ItemManager* instance; ///< Instancia nica de la clase (Singleton).
 
     /**
@@ -84,4 +104,9 @@ private:
      * asigna la lista del nivel inicial a `currentItems`.
      */
     ItemManager();
+
+    /**
+     * @brief Vuelve a llenar `itemGrid` con los tems actuales.
+     */
+    void rebuildGrid();
 };
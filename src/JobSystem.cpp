@@ -0,0 +1,97 @@
+#include <algorithm>
+#include "JobSystem.h"
+
+void JobSystem::parallelFor(int count, int chunkSize, const std::function<void(int chunk, int begin, int end)>& job)
+{
+	int chunks = (count + chunkSize - 1) / chunkSize;
+	if (chunks <= 1 || workers.empty()) {
+		for (int chunk = 0; chunk < chunks; chunk++) {
+			job(chunk, chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize));
+		}
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(mutex);
+	this->job = &job;
+	this->count = count;
+	this->chunkSize = chunkSize;
+	chunkCount = chunks;
+	nextChunk = 0;
+	finishedChunks = 0;
+	batch++;
+	lock.unlock();
+	jobReady.notify_all();
+
+	//the caller works too instead of just waiting
+	int done = runChunks();
+	lock.lock();
+	finishedChunks += done;
+	//a worker still holding the job could take a chunk of the next batch, wait for all of them to let go
+	jobDone.wait(lock, [this] { return finishedChunks == chunkCount && activeWorkers == 0; });
+	this->job = nullptr;
+}
+
+int JobSystem::getThreadCount()
+{
+	return workers.size() + 1;
+}
+
+JobSystem* JobSystem::instance;
+
+JobSystem* JobSystem::getInstance()
+{
+	if (!instance) {
+		instance = new JobSystem();
+	}
+	return instance;
+}
+
+int JobSystem::runChunks()
+{
+	int done = 0;
+	while (true) {
+		int chunk = nextChunk.fetch_add(1);
+		if (chunk >= chunkCount) {
+			break;
+		}
+		(*job)(chunk, chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize));
+		done++;
+	}
+	return done;
+}
+
+void JobSystem::run()
+{
+	unsigned int seenBatch = 0;
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		jobReady.wait(lock, [this, seenBatch] { return batch != seenBatch && job; });
+		seenBatch = batch;
+		activeWorkers++;
+		lock.unlock();
+
+		int done = runChunks();
+
+		lock.lock();
+		finishedChunks += done;
+		activeWorkers--;
+		jobDone.notify_all();
+	}
+}
+
+JobSystem::JobSystem()
+{
+	job = nullptr;
+	count = 0;
+	chunkSize = 1;
+	chunkCount = 0;
+	nextChunk = 0;
+	finishedChunks = 0;
+	activeWorkers = 0;
+	batch = 0;
+	int cores = std::thread::hardware_concurrency();
+	int workerCount = std::clamp(cores - 2, 0, MAX_JOB_WORKERS);
+	for (int i = 0; i < workerCount; i++) {
+		workers.emplace_back(&JobSystem::run, this);
+	}
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#define MAX_JOB_WORKERS 8
+
+/**
+ * @class JobSystem
+ * @brief Reparte trabajo en bloques entre un grupo fijo de hilos.
+ *
+ * Los hilos se crean una sola vez y esperan trabajo. `parallelFor` divide un rango en
+ * bloques, y el hilo que llama y los del grupo van tomando bloques hasta terminarlos.
+ * Cada bloque se procesa entero en un solo hilo, así que el trabajo de un bloque puede
+ * escribir en datos propios del bloque sin sincronizarse.
+ */
+class JobSystem {
+public:
+    /**
+     * @brief Ejecuta una función sobre todos los bloques de un rango y espera a que terminen.
+     *
+     * Si el rango entra en un solo bloque se ejecuta directamente en el hilo que llama.
+     *
+     * @param count Cantidad de elementos del rango.
+     * @param chunkSize Elementos por bloque.
+     * @param job Función que recibe el número de bloque y su rango `[begin, end)`.
+     */
+    void parallelFor(int count, int chunkSize, const std::function<void(int chunk, int begin, int end)>& job);
+
+    /**
+     * @brief Cantidad de hilos que pueden trabajar a la vez, contando al que llama.
+     * @return Número de hilos.
+     */
+    int getThreadCount();
+
+    /**
+     * @brief Obtiene la instancia única de `JobSystem`.
+     * @return Puntero a la instancia única.
+     */
+    static JobSystem* getInstance();
+
+private:
+    std::vector<std::thread> workers;        ///< Hilos del grupo.
+    std::mutex mutex;                        ///< Protege el trabajo actual.
+    std::condition_variable jobReady;        ///< Avisa a los hilos que hay trabajo nuevo.
+    std::condition_variable jobDone;         ///< Avisa al que llama que terminó un bloque.
+    const std::function<void(int, int, int)>* job; ///< Trabajo actual, o nullptr.
+    int count;                               ///< Elementos del trabajo actual.
+    int chunkSize;                           ///< Elementos por bloque del trabajo actual.
+    int chunkCount;                          ///< Bloques del trabajo actual.
+    std::atomic<int> nextChunk;              ///< Próximo bloque sin tomar.
+    int finishedChunks;                      ///< Bloques terminados.
+    int activeWorkers;                       ///< Hilos del grupo que están tomando bloques.
+    unsigned int batch;                      ///< Número del trabajo actual.
+    static JobSystem* instance;              ///< Instancia única de la clase (Singleton).
+
+    /**
+     * @brief Toma y ejecuta bloques del trabajo actual hasta que no queden.
+     *
+     * @return Cantidad de bloques ejecutados.
+     */
+    int runChunks();
+
+    /**
+     * @brief Bucle de cada hilo del grupo.
+     */
+    void run();
+
+    /**
+     * @brief Constructor privado; crea los hilos según los núcleos disponibles.
+     *
+     * Deja libres dos núcleos, para el hilo principal y el de simulación.
+     */
+    JobSystem();
+};
@@ -0,0 +1,88 @@
+#include <cmath>
+#include <algorithm>
+#include "LightMap.h"
+#include "Lamp.h"
+
+void LightMap::bake(Map& map, const std::vector<Item*>& items)
+{
+	std::vector<float> intensity(resolution * resolution, 0.f);
+	int radius = (int)std::ceil(LAMP_RADIUS * LIGHTMAP_SUBDIVISIONS);
+	for (auto item : items) {
+		Lamp* lampPtr = dynamic_cast<Lamp*>(item);
+		if (!lampPtr) {
+			continue;
+		}
+		Point2D lampPos = lampPtr->position;
+		int centerX = (int)(lampPos.x * LIGHTMAP_SUBDIVISIONS);
+		int centerY = (int)(lampPos.y * LIGHTMAP_SUBDIVISIONS);
+		//only the subcells inside the lamp radius can receive its light
+		for (int y = std::max(0, centerY - radius); y <= std::min(resolution - 1, centerY + radius); y++) {
+			for (int x = std::max(0, centerX - radius); x <= std::min(resolution - 1, centerX + radius); x++) {
+				Point2D sample = { (x + 0.5) / LIGHTMAP_SUBDIVISIONS, (y + 0.5) / LIGHTMAP_SUBDIVISIONS };
+				if (!map.isPositionEmpty((int)sample.y, (int)sample.x)) {
+					continue;
+				}
+				double dist = std::hypot(sample.x - lampPos.x, sample.y - lampPos.y);
+				if (dist >= LAMP_RADIUS || !isLineClear(map, lampPos, sample)) {
+					continue;
+				}
+				double falloff = 1 - dist / LAMP_RADIUS;
+				intensity[y * resolution + x] += (float)(LAMP_BRIGHTNESS * falloff * falloff);
+			}
+		}
+	}
+	for (int i = 0; i < resolution * resolution; i++) {
+		cells[i] = (uint8_t)std::min(255.f, intensity[i]);
+	}
+}
+
+int LightMap::getLight(double x, double y) const
+{
+	int cellX = (int)(x * LIGHTMAP_SUBDIVISIONS);
+	int cellY = (int)(y * LIGHTMAP_SUBDIVISIONS);
+	if (cellX < 0 || cellY < 0 || cellX >= resolution || cellY >= resolution) {
+		return 0;
+	}
+	return cells[cellY * resolution + cellX];
+}
+
+const uint8_t* LightMap::getCells() const
+{
+	return cells.data();
+}
+
+int LightMap::getResolution() const
+{
+	return resolution;
+}
+
+bool LightMap::isLineClear(Map& map, Point2D from, Point2D to)
+{
+	//march in steps smaller than a subcell so thin walls aren't skipped
+	double dx = to.x - from.x;
+	double dy = to.y - from.y;
+	int steps = (int)std::ceil(std::hypot(dx, dy) * LIGHTMAP_SUBDIVISIONS * 2);
+	for (int i = 1; i < steps; i++) {
+		double t = (double)i / steps;
+		if (!map.isPositionEmpty((int)(from.y + dy * t), (int)(from.x + dx * t))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+LightMap* LightMap::instance;
+
+LightMap* LightMap::getInstance()
+{
+	if (!instance) {
+		instance = new LightMap();
+	}
+	return instance;
+}
+
+LightMap::LightMap()
+{
+	resolution = GRID_SIZE * LIGHTMAP_SUBDIVISIONS;
+	cells.assign(resolution * resolution, 0);
+}
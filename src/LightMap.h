@@ -0,0 +1,78 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "Map.h"
+#include "Item.h"
+#define LIGHTMAP_SUBDIVISIONS 2
+#define LAMP_RADIUS 6.0
+#define LAMP_BRIGHTNESS 180
+
+/**
+ * @class LightMap
+ * @brief Mapa de luz estática horneado a partir de las lámparas del nivel.
+ *
+ * Al cargar un nivel se calcula, para cada subcelda del mapa, la luz que recibe de
+ * las lámparas que la ven sin paredes en medio. Durante el juego la luz se consulta
+ * en O(1) y se suma a la atenuación por oscuridad del `Canvas`.
+ */
+class LightMap {
+public:
+    /**
+     * @brief Calcula la luz de cada subcelda del nivel actual.
+     *
+     * Las paredes y las puertas bloquean la luz; las puertas se consideran cerradas,
+     * que es su estado al empezar el nivel.
+     *
+     * @param map Mapa del nivel actual.
+     * @param items Ítems del nivel; solo se usan las lámparas.
+     */
+    void bake(Map& map, const std::vector<Item*>& items);
+
+    /**
+     * @brief Obtiene la luz en una posición del mundo.
+     *
+     * @param x Coordenada X en unidades del mundo.
+     * @param y Coordenada Y en unidades del mundo.
+     * @return Luz añadida en unidades de color, entre 0 y 255.
+     */
+    int getLight(double x, double y) const;
+
+    /**
+     * @brief Acceso directo a las subceldas, para los recorridos por píxel del renderizador.
+     *
+     * @return Luz de cada subcelda, fila por fila, con `getResolution()` subceldas por lado.
+     */
+    const uint8_t* getCells() const;
+
+    /**
+     * @brief Número de subceldas por lado del mapa de luz.
+     * @return `GRID_SIZE * LIGHTMAP_SUBDIVISIONS`.
+     */
+    int getResolution() const;
+
+    /**
+     * @brief Obtiene la instancia única de `LightMap`.
+     * @return Puntero a la instancia única.
+     */
+    static LightMap* getInstance();
+
+private:
+    std::vector<uint8_t> cells; ///< Luz de cada subcelda en unidades de color.
+    int resolution;             ///< Subceldas por lado.
+    static LightMap* instance;  ///< Instancia única de la clase (Singleton).
+
+    /**
+     * @brief Comprueba si la luz de una lámpara llega a un punto.
+     *
+     * @param map Mapa del nivel actual.
+     * @param from Posición de la lámpara.
+     * @param to Punto iluminado.
+     * @return true si no hay paredes entre ambos puntos.
+     */
+    bool isLineClear(Map& map, Point2D from, Point2D to);
+
+    /**
+     * @brief Constructor privado; el mapa empieza sin luz.
+     */
+    LightMap();
+};
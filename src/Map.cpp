@@ -4,9 +4,9 @@
 #include "Map.h"
 #include "Enumerations.h"
 #include "FileReader.h"
-#include "SoundManager.h"
+#include "AudioSystem.h"
 
-bool Map::isPositionEmpty(int row, int column)
+bool Map::isPositionEmpty(int row, int column) const
 {
 	bool isRowValid = row >= 0  && row < GRID_SIZE;
 	bool isColumnValid = column >= 0 && column < GRID_SIZE;
@@ -28,18 +28,62 @@ bool Map::isDoor(int row, int column)
 
 void Map::toggleDoor(int row, int column)
 {
-	auto sndMgr = SoundManager::getInstance();
-	Sound door = sndMgr->getSound("door_open.mp3");
-	PlaySound(door);
+	AudioSystem::getInstance()->playAt(doorSound, { column + 0.5, row + 0.5 });
 	if (currentMap[row][column] == closedDoor) {
 		currentMap[row][column] = openDoor;
 	}
 	else{
 		currentMap[row][column] = closedDoor;
 	}
+	revision++;
 }
 
-WallType Map::getElementAt(int row, int column)
+WallType Map::getFloorAt(int row, int column)
+{
+	bool isRowValid = row >= 0  && row < GRID_SIZE;
+	bool isColumnValid = column >= 0 && column < GRID_SIZE;
+	if (isRowValid && isColumnValid) {
+		return currentFloor[row][column];
+	}
+	return none;
+}
+
+WallType Map::getCeilingAt(int row, int column)
+{
+	bool isRowValid = row >= 0  && row < GRID_SIZE;
+	bool isColumnValid = column >= 0 && column < GRID_SIZE;
+	if (isRowValid && isColumnValid) {
+		return currentCeiling[row][column];
+	}
+	return none;
+}
+
+Map Map::createSnapshot() const
+{
+	return Map(this);
+}
+
+void Map::copyCells(const Map& source)
+{
+	for (int row = 0; row < GRID_SIZE; row++) {
+		std::copy(source.currentMap[row], source.currentMap[row] + GRID_SIZE, currentMap[row]);
+	}
+	currentFloor = source.currentFloor;
+	currentCeiling = source.currentCeiling;
+	currentMapIndex = source.currentMapIndex;
+}
+
+WallType** Map::getFloorGrid() const
+{
+	return currentFloor;
+}
+
+WallType** Map::getCeilingGrid() const
+{
+	return currentCeiling;
+}
+
+WallType Map::getElementAt(int row, int column) const
 {
 	bool isRowValid = row >= 0  && row < GRID_SIZE;
 	bool isColumnValid = column >= 0 && column < GRID_SIZE;
@@ -64,10 +108,7 @@ void Map::loadMaps()
 		auto extension = std::string(GetFileExtension(path.c_str()));
 		if (extension == ".txt") {
 			//create new map
-			WallType** newMap = new WallType* [GRID_SIZE];
-			for (int i = 0; i < GRID_SIZE; i++) {
-				newMap[i] = new WallType[GRID_SIZE];
-			}
+			WallType** newMap = createGrid();
 
 			if (FileReader::readMapFromFile(path.c_str(), newMap)) {
 				std::cout << "map loaded succesfully from " << path << std::endl;
@@ -76,6 +117,11 @@ void Map::loadMaps()
 				std::cout << "error loading map " << path << std::endl;
 			}
 			maps.push_back(newMap);
+
+			//floor and ceiling textures share the map's file name
+			std::string basePath = path.substr(0, path.size() - extension.size());
+			floors.push_back(loadSurface(basePath + ".floor"));
+			ceilings.push_back(loadSurface(basePath + ".ceiling"));
 		}
 	}
 }
@@ -93,6 +139,7 @@ void Map::restoreMaps()
 			}
 		}
 	}
+	revision++;
 }
 
 int Map::getCurrentIndex()
@@ -105,6 +152,9 @@ void Map::setLevel(int level)
 	if (level < maps.size()) {
 		currentMapIndex = level;
 		currentMap = maps[currentMapIndex];
+		currentFloor = floors[currentMapIndex];
+		currentCeiling = ceilings[currentMapIndex];
+		revision++;
 	}
 }
 
@@ -113,6 +163,39 @@ int Map::getMapCount()
 	return maps.size();
 }
 
+void Map::save(StateWriter& out)
+{
+	//wall types fit in a byte, a row at a time
+	uint8_t row[GRID_SIZE];
+	for (int i = 0; i < GRID_SIZE; i++) {
+		for (int j = 0; j < GRID_SIZE; j++) {
+			row[j] = currentMap[i][j];
+		}
+		out.writeBlock(row, GRID_SIZE);
+	}
+}
+
+bool Map::load(StateReader& in)
+{
+	uint8_t row[GRID_SIZE];
+	for (int i = 0; i < GRID_SIZE; i++) {
+		if (!in.readBlock(row, GRID_SIZE)) {
+			return false;
+		}
+		for (int j = 0; j < GRID_SIZE; j++) {
+			currentMap[i][j] = WallType(row[j]);
+		}
+	}
+	//doors may have changed, paths are rebuilt
+	revision++;
+	return true;
+}
+
+unsigned int Map::getRevision() const
+{
+	return revision;
+}
+
 Map* Map::instance;
 
 Map* Map::getInstance()
@@ -130,9 +213,51 @@ void Map::normalizePathSeparator(char *path)
     }
 }
 
+WallType** Map::createGrid()
+{
+	WallType** grid = new WallType* [GRID_SIZE];
+	for (int i = 0; i < GRID_SIZE; i++) {
+		grid[i] = new WallType[GRID_SIZE]();
+	}
+	return grid;
+}
+
+WallType** Map::loadSurface(const std::string& path)
+{
+	WallType** surface = createGrid();
+	if (FileExists(path.c_str())) {
+		FileReader::readMapFromFile(path.c_str(), surface);
+	}
+	//the renderers index their textures with these ids, an unknown one is left untextured
+	for (int row = 0; row < GRID_SIZE; row++) {
+		for (int column = 0; column < GRID_SIZE; column++) {
+			if (surface[row][column] < none || surface[row][column] > openDoor) {
+				surface[row][column] = none;
+			}
+		}
+	}
+	return surface;
+}
+
 Map::Map()
 {
 	currentMapIndex = 0;
+	revision = 0;
 	loadMaps();
 	currentMap = maps[currentMapIndex];
+	currentFloor = floors[currentMapIndex];
+	currentCeiling = ceilings[currentMapIndex];
+}
+
+Map::Map(const Map* source)
+{
+	//the snapshot owns its cells, so they go away with the snapshot
+	snapshotCells.reset(new WallType[GRID_SIZE * GRID_SIZE]);
+	snapshotRows.reset(new WallType*[GRID_SIZE]);
+	for (int row = 0; row < GRID_SIZE; row++) {
+		snapshotRows[row] = &snapshotCells[row * GRID_SIZE];
+	}
+	currentMap = snapshotRows.get();
+	revision = source->revision;
+	copyCells(*source);
 }
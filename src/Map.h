@@ -1,7 +1,10 @@
 #pragma once
 #include <vector>
+#include <string>
+#include <memory>
 #include "Point2D.h"
 #include "Enumerations.h"
+#include "SaveState.h"
 #define GRID_SIZE 100
 
 /**
@@ -22,7 +25,7 @@ public:
      * @param column Columna en la cuadr�cula.
      * @return `true` si la posici�n est� vac�a o contiene una puerta abierta, `false` en caso contrario.
      */
-    bool isPositionEmpty(int row, int column);
+    bool isPositionEmpty(int row, int column) const;
 
     /**
      * @brief Comprueba si una posici�n contiene una puerta.
@@ -53,14 +56,70 @@ public:
      *
      * Retorna `none` si la posici�n est� fuera de los l�mites.
      */
-    WallType getElementAt(int row, int column);
+    WallType getElementAt(int row, int column) const;
+
+    /**
+     * @brief Obtiene la textura del suelo en una celda del nivel actual.
+     *
+     * @param row Fila en la cuadrícula.
+     * @param column Columna en la cuadrícula.
+     * @return Identificador de textura (`WallType`); `none` si la celda no tiene suelo texturizado.
+     */
+    WallType getFloorAt(int row, int column);
+
+    /**
+     * @brief Obtiene la textura del techo en una celda del nivel actual.
+     *
+     * @param row Fila en la cuadrícula.
+     * @param column Columna en la cuadrícula.
+     * @return Identificador de textura (`WallType`); `none` si la celda está a cielo abierto.
+     */
+    WallType getCeilingAt(int row, int column);
+
+    /**
+     * @brief Obtiene la cuadrícula de texturas de suelo del nivel actual.
+     *
+     * Pensado para los recorridos por píxel del renderizador, que no pueden pagar
+     * una comprobación de límites por llamada.
+     *
+     * @return Matriz `GRID_SIZE x GRID_SIZE` con el identificador de textura de cada celda.
+     */
+    WallType** getFloorGrid() const;
+
+    /**
+     * @brief Obtiene la cuadrícula de texturas de techo del nivel actual.
+     *
+     * @return Matriz `GRID_SIZE x GRID_SIZE` con el identificador de textura de cada celda.
+     */
+    WallType** getCeilingGrid() const;
+
+    /**
+     * @brief Crea una copia del nivel actual con su propia cuadrícula de paredes.
+     *
+     * La copia no comparte memoria con el mapa original salvo las cuadrículas de suelo
+     * y techo, que no cambian durante el juego. La usa el hilo de dibujo para lanzar
+     * rayos mientras la simulación abre y cierra puertas en el original.
+     *
+     * @return Mapa independiente con el contenido del nivel actual.
+     */
+    Map createSnapshot() const;
+
+    /**
+     * @brief Copia el nivel actual de otro mapa en la cuadrícula propia de una copia.
+     *
+     * Solo debe llamarse sobre mapas creados con `createSnapshot`.
+     *
+     * @param source Mapa del que se copian las celdas.
+     */
+    void copyCells(const Map& source);
 
     /**
      * @brief Carga los mapas desde archivos de datos.
      *
      * Lee todos los archivos `.txt` en la carpeta de datos y crea una representaci�n de
      * los mapas como matrices bidimensionales (`WallType**`). Los mapas se almacenan en
-     * el atributo `maps`.
+     * el atributo `maps`. Para cada `mapN.txt` también se leen, si existen, `mapN.floor`
+     * y `mapN.ceiling` con las texturas de suelo y techo de cada celda.
      */
     void loadMaps();
 
@@ -95,6 +154,32 @@ public:
      */
     int getMapCount();
 
+    /**
+     * @brief Obtiene la revisión del nivel actual.
+     *
+     * Aumenta cada vez que cambia qué celdas son transitables (al abrir o cerrar una
+     * puerta, restaurar los mapas o cambiar de nivel), para que quien guarde datos
+     * derivados del mapa sepa cuándo recalcularlos.
+     *
+     * @return Número de revisión.
+     */
+    unsigned int getRevision() const;
+
+    /**
+     * @brief Guarda las celdas del mapa activo, con las puertas como estén.
+     *
+     * @param out Destino.
+     */
+    void save(StateWriter& out);
+
+    /**
+     * @brief Restaura en el mapa activo las celdas que guardó `save`.
+     *
+     * @param in Origen.
+     * @return false si faltaban datos.
+     */
+    bool load(StateReader& in);
+
     /**
      * @brief Obtiene la instancia �nica de `Map`.
      *
@@ -107,14 +192,45 @@ public:
 private:
     std::vector<WallType**> maps; ///< Lista de mapas representados como matrices bidimensionales.
     WallType** currentMap; ///< Puntero al mapa actualmente activo.
+    std::vector<WallType**> floors; ///< Texturas de suelo por celda de cada mapa.
+    std::vector<WallType**> ceilings; ///< Texturas de techo por celda de cada mapa.
+    WallType** currentFloor; ///< Texturas de suelo del mapa activo.
+    WallType** currentCeiling; ///< Texturas de techo del mapa activo.
+    std::unique_ptr<WallType[]> snapshotCells; ///< Celdas propias de una copia hecha con `createSnapshot`; vacío en el mapa original.
+    std::unique_ptr<WallType*[]> snapshotRows; ///< Filas de `snapshotCells`, a las que apunta `currentMap` en una copia.
+    unsigned int revision; ///< Revisión de las celdas transitables, ver `getRevision`.
     int currentMapIndex; ///< �ndice del mapa actualmente activo.
     static Map* instance; ///< Instancia �nica de la clase (Singleton).
     void normalizePathSeparator(char* path);
 
+    /**
+     * @brief Reserva una cuadrícula `GRID_SIZE x GRID_SIZE` inicializada en `none`.
+     *
+     * @return Puntero a la nueva cuadrícula.
+     */
+    WallType** createGrid();
+
+    /**
+     * @brief Lee una cuadrícula de texturas de suelo o techo.
+     *
+     * Los ids fuera de `none`..`openDoor` se reemplazan por `none`.
+     *
+     * @param path Ruta del archivo; si no existe la cuadrícula queda vacía.
+     * @return La cuadrícula leída.
+     */
+    WallType** loadSurface(const std::string& path);
+
     /**
      * @brief Constructor privado de la clase `Map`.
      *
      * Inicializa el �ndice del mapa actual y carga los mapas desde los datos.
      */
     Map();
+
+    /**
+     * @brief Construye una copia del nivel actual de otro mapa, ver `createSnapshot`.
+     *
+     * @param source Mapa del que se copia el nivel.
+     */
+    explicit Map(const Map* source);
 };
@@ -3,36 +3,41 @@
 #include <cmath>
 #include "Player.h"
 #include "TextureManager.h"
-#include "SoundManager.h" 
+#include "AudioSystem.h"
+#include "GameClock.h"
+#include "AnimationLibrary.h"
 
 void Player::act(Map& map)
 {
+	previousPosition = position;
+	previousAngle = angle;
 	if (isAlive()) {
 		move(map);
 		attack();
 	}
-	hurtTimer += GetFrameTime();
+	hurtTimer += GameClock::getInstance()->getDeltaTime();
 }
 
 void Player::move(Map& map)
 {
 	double cosAngle = cos(angle);
 	double sinAngle = sin(angle);
-	double speedPlayer = speed * GetFrameTime();
+	double deltaTime = GameClock::getInstance()->getDeltaTime();
+	double speedPlayer = speed * deltaTime;
 	Point2D d = { 0,0 };
-	if (IsKeyDown(KEY_W)) {
+	if (input.moveForward) {
 		d.x += speedPlayer * cosAngle;
 		d.y += speedPlayer * sinAngle;
 	}
-	if (IsKeyDown(KEY_S)) {
+	if (input.moveBackward) {
 		d.x += -speedPlayer * cosAngle;
 		d.y += -speedPlayer * sinAngle;
 	}
-	if (IsKeyDown(KEY_A)) {
+	if (input.strafeLeft) {
 		d.x += speedPlayer * sinAngle;
 		d.y += -speedPlayer * cosAngle;
 	}
-	if (IsKeyDown(KEY_D)) {
+	if (input.strafeRight) {
 		d.x += -speedPlayer * sinAngle;
 		d.y += speedPlayer * cosAngle;
 	}
@@ -48,7 +53,7 @@ void Player::move(Map& map)
 	bool isNearDoorX = map.isDoor(int(position.y), int(position.x + d.x));
 	bool isNearDoor = isNearDoorX || isNearDoorY;
 
-	if (isNearDoor && IsKeyPressed(KEY_SPACE) && !map.isDoor(int(position.y), int(position.x)) ) {
+	if (isNearDoor && input.use && !map.isDoor(int(position.y), int(position.x)) ) {
 		if (isNearDoorX) {
 			map.toggleDoor(int(position.y), int(position.x + d.x));
 		}
@@ -57,27 +62,22 @@ void Player::move(Map& map)
 		}
 	}
 
-	SoundManager* soundManager = SoundManager::getInstance();
-	Sound walkSound = soundManager->getSound("walk.mp3");
-	if (IsKeyDown(KEY_W) || IsKeyDown(KEY_A) || IsKeyDown(KEY_S) || IsKeyDown(KEY_D)) {
-		if (!IsSoundPlaying(walkSound)) {
-			PlaySound(walkSound);
-		}
+	AudioSystem* audio = AudioSystem::getInstance();
+	if (input.moveForward || input.strafeLeft || input.moveBackward || input.strafeRight) {
+		audio->playIfIdle(walkSound);
 	}
 	else {
-		if (IsSoundPlaying(walkSound)) {
-			StopSound(walkSound);
-		}
+		audio->stop(walkSound);
 	}
 
-	if (GetMouseDelta().x < 0) {
-		angle -= sensibility * GetFrameTime() * -GetMouseDelta().x;
+	if (input.mouseDeltaX < 0) {
+		angle -= sensibility * deltaTime * -input.mouseDeltaX;
 		if (angle < 0) {
 			angle = 2 * PI;
 		}
 	}
-	if (GetMouseDelta().x > 0) {
-		angle += sensibility * GetFrameTime() * GetMouseDelta().x;
+	if (input.mouseDeltaX > 0) {
+		angle += sensibility * deltaTime * input.mouseDeltaX;
 		if (angle > 2 * PI) {
 			angle = 0;
 		}
@@ -87,9 +87,7 @@ void Player::move(Map& map)
 void Player::takeDamage(int damage)
 {
 	if (hurtTimer > 0.3) {
-		SoundManager* soundManager = SoundManager::getInstance();
-		Sound hurtSound = soundManager->getSound("EnemyAttack.mp3"); //sonido de da�o
-		PlaySound(hurtSound);
+		AudioSystem::getInstance()->play(playerHurtSound, SOUND_PRIORITY_HIGH); //sonido de da�o
 		health -= damage;
 		hurtTimer = 0;
 	}
@@ -97,23 +95,19 @@ void Player::takeDamage(int damage)
 
 void Player::attack()
 {
-	if (IsMouseButtonDown(MOUSE_BUTTON_LEFT) && weapon->canShoot()) {
+	if (input.fire && weapon->canShoot()) {
 		weapon->shoot();
 		justShot = true;
 	}
-	else if (!weapon->canShoot() && IsMouseButtonDown(MOUSE_BUTTON_LEFT)) {
-		SoundManager* soundManager = SoundManager::getInstance();
-		Sound noAmmoSound = soundManager->getSound("reload.mp3"); //sonido cuando no hay balas
-		PlaySound(noAmmoSound);
+	else if (!weapon->canShoot() && input.fire) {
+		AudioSystem::getInstance()->play(reloadSound); //sonido cuando no hay balas
 	}
 }
 
 bool Player::heal(int healthPoints)
 {
 	if (health < maxHealth) {
-		SoundManager* soundManager = SoundManager::getInstance();
-		Sound healSound = soundManager->getSound("heal.mp3"); //sonido de recogida de vida
-		PlaySound(healSound);
+		AudioSystem::getInstance()->play(healSound); //sonido de recogida de vida
 		if (healthPoints + health > maxHealth) {
 			health = maxHealth;
 		}
@@ -130,10 +124,42 @@ void Player::reset()
 	health = maxHealth;
 	angle = PI/2;
 	position = { 2, 2 };
+	previousPosition = position;
+	previousAngle = angle;
 	justShot = false;
 	weapon->refillAmmo(10);
 }
 
+void Player::save(StateWriter& out)
+{
+	out.write(position);
+	out.write(angle);
+	out.write(previousPosition);
+	out.write(previousAngle);
+	out.write<int32_t>(health);
+	out.write(hurt);
+	out.write(hurtTimer);
+	out.write(justShot);
+	weapon->save(out);
+}
+
+bool Player::load(StateReader& in)
+{
+	int32_t savedHealth;
+	bool ok = in.read(position) && in.read(angle) && in.read(previousPosition) && in.read(previousAngle) &&
+		in.read(savedHealth) && in.read(hurt) && in.read(hurtTimer) && in.read(justShot);
+	if (!ok) {
+		return false;
+	}
+	health = savedHealth;
+	return weapon->load(in);
+}
+
+void Player::setInput(const InputFrame& input)
+{
+	this->input = input;
+}
+
 void Player::setSensibility(double sensibility)
 {
 	this->sensibility = sensibility;
@@ -170,6 +196,7 @@ Player::Player()
 	hurt = false;
 	weapon = new Weapon();
 	justShot = false;
+	input = {};
 
 
 	//initialize weapon texture
@@ -182,12 +209,5 @@ Player::Player()
 	weapon->sprite->positionOnWindow.width = staticTex.width;
 	weapon->sprite->positionOnWindow.height = staticTex.height;
 	//shooting animation
-	Animation shooting = {};
-	shooting.texture = texMgr->getTexture("sprites/animated/gun.png");
-	shooting.numFrames = 11;
-	shooting.animationSpeed = 5.0;
-	shooting.textureArea = { 0, 0, (float)shooting.texture.width, (float)shooting.texture.height };
-	shooting.positionOnWindow.width = (float)(shooting.texture.width / shooting.numFrames);
-	shooting.positionOnWindow.height = (float)(shooting.texture.height);
-	weapon->sprite->animations.push_back(shooting);
+	weapon->sprite->animations.push_back(AnimationLibrary::getInstance()->getAnimation("shotgun"));
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include "Entity.h"
 #include "Weapon.h"
+#include "InputFrame.h"
 
 /**
  * @class Player
@@ -18,6 +19,12 @@ public:
     /// Indica si el jugador dispar� recientemente.
     bool justShot;
 
+    /// Posición al empezar el tick actual, para interpolar el dibujo.
+    Point2D previousPosition;
+
+    /// Ángulo al empezar el tick actual, para interpolar el dibujo.
+    double previousAngle;
+
     /**
      * @brief Realiza las acciones principales del jugador.
      *
@@ -74,6 +81,31 @@ public:
      */
     void reset();
 
+    /**
+     * @brief Guarda la posición, la vida y el arma del jugador.
+     *
+     * @param out Destino.
+     */
+    void save(StateWriter& out);
+
+    /**
+     * @brief Restaura lo que guardó `save`.
+     *
+     * @param in Origen.
+     * @return false si faltaban datos.
+     */
+    bool load(StateReader& in);
+
+    /**
+     * @brief Entrega al jugador la entrada del tick que se va a simular.
+     *
+     * `move` y `attack` leen esta entrada en lugar de consultar a raylib,
+     * porque la simulación no corre en el hilo principal.
+     *
+     * @param input Entrada muestreada en el hilo principal.
+     */
+    void setInput(const InputFrame& input);
+
     /**
      * @brief Establece la sensibilidad del jugador al mover la c�mara.
      *
@@ -114,6 +146,9 @@ private:
     /// Temporizador para gestionar el intervalo entre da�os consecutivos.
     double hurtTimer;
 
+    /// Entrada del tick actual, asignada con `setInput`.
+    InputFrame input;
+
     /// Instancia �nica de `Player` para el patr�n Singleton.
     static Player* instance;
     
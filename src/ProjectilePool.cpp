@@ -0,0 +1,166 @@
+#include <cmath>
+#include <algorithm>
+#include "ProjectilePool.h"
+#include "AudioSystem.h"
+#include "AnimationLibrary.h"
+#include "AnimationSystem.h"
+#include "GameClock.h"
+
+bool ProjectilePool::spawn(Point2D position, double angle, int damage)
+{
+	if (count == MAX_PROJECTILES) {
+		return false;
+	}
+	posX[count] = position.x;
+	posY[count] = position.y;
+	velX[count] = cos(angle) * PROJECTILE_SPEED;
+	velY[count] = sin(angle) * PROJECTILE_SPEED;
+	timer[count] = 0;
+	this->damage[count] = damage;
+	hit[count] = 0;
+	grid.insert(count, position);
+	count++;
+	return true;
+}
+
+void ProjectilePool::update(Player& player, Map& map, double deltaTime)
+{
+	//clips need the textures in VRAM, so the shared sprite is set up on first use
+	if (sprite.animations.empty()) {
+		sprite.animations.push_back(AnimationLibrary::getInstance()->getAnimation("fireball"));
+	}
+	//every fireball shares one sprite, keep its animation registered
+	AnimationSystem::getInstance()->play(sprite, 0, true);
+
+	//only projectiles in the cells around the player can hit it
+	nearby.clear();
+	grid.queryRadius(player.position, PROJECTILE_HIT_RADIUS, nearby);
+	for (int index : nearby) {
+		hit[index] = 1;
+	}
+
+	AudioSystem* audio = AudioSystem::getInstance();
+	double lookAhead = PROJECTILE_HIT_RADIUS / PROJECTILE_SPEED;
+	for (int i = 0; i < count; ) {
+		bool hitPlayer = hit[i];
+		//a wall half a cell ahead, same threshold the per-projectile ray cast used
+		int aheadRow = int(posY[i] + velY[i] * lookAhead);
+		int aheadColumn = int(posX[i] + velX[i] * lookAhead);
+		bool hitWall = !map.isPositionEmpty(aheadRow, aheadColumn);
+
+		if (hitPlayer || hitWall || timer[i] > PROJECTILE_TIME_LIMIT) {
+			audio->stop(zombieShootSound);
+			audio->playAt(projectileExplodeSound, { posX[i], posY[i] }, SOUND_PRIORITY_LOW);
+			if (hitPlayer) {
+				player.takeDamage(damage[i]);
+			}
+			remove(i);
+			continue;
+		}
+		posX[i] += velX[i] * deltaTime;
+		posY[i] += velY[i] * deltaTime;
+		timer[i] += deltaTime;
+		grid.update(i, { posX[i], posY[i] });
+		i++;
+	}
+}
+
+void ProjectilePool::clear()
+{
+	count = 0;
+	grid.clear();
+}
+
+void ProjectilePool::save(StateWriter& out)
+{
+	out.write<int32_t>(count);
+	out.writeBlock(posX.data(), count);
+	out.writeBlock(posY.data(), count);
+	out.writeBlock(velX.data(), count);
+	out.writeBlock(velY.data(), count);
+	out.writeBlock(timer.data(), count);
+	out.writeBlock(damage.data(), count);
+	out.writeBlock(hit.data(), count);
+	AnimationSystem::getInstance()->save(sprite, out);
+}
+
+bool ProjectilePool::load(StateReader& in)
+{
+	clear();
+	int32_t saved;
+	if (!in.read(saved) || saved < 0 || saved > MAX_PROJECTILES) {
+		return false;
+	}
+	bool ok = in.readBlock(posX.data(), saved) &&
+		in.readBlock(posY.data(), saved) &&
+		in.readBlock(velX.data(), saved) &&
+		in.readBlock(velY.data(), saved) &&
+		in.readBlock(timer.data(), saved) &&
+		in.readBlock(damage.data(), saved) &&
+		in.readBlock(hit.data(), saved);
+	if (!ok) {
+		return false;
+	}
+	count = saved;
+	for (int i = 0; i < count; i++) {
+		grid.insert(i, { posX[i], posY[i] });
+	}
+	if (sprite.animations.empty()) {
+		sprite.animations.push_back(AnimationLibrary::getInstance()->getAnimation("fireball"));
+	}
+	return AnimationSystem::getInstance()->load(sprite, in);
+}
+
+int ProjectilePool::size() const
+{
+	return count;
+}
+
+Point2D ProjectilePool::getPosition(int index) const
+{
+	return { posX[index], posY[index] };
+}
+
+Point2D ProjectilePool::getPreviousPosition(int index) const
+{
+	double elapsed = std::min(timer[index], FIXED_TIMESTEP);
+	return { posX[index] - velX[index] * elapsed, posY[index] - velY[index] * elapsed };
+}
+
+Animated& ProjectilePool::getSprite()
+{
+	return sprite;
+}
+
+ProjectilePool::ProjectilePool()
+{
+	count = 0;
+	posX.resize(MAX_PROJECTILES);
+	posY.resize(MAX_PROJECTILES);
+	velX.resize(MAX_PROJECTILES);
+	velY.resize(MAX_PROJECTILES);
+	timer.resize(MAX_PROJECTILES);
+	damage.resize(MAX_PROJECTILES);
+	hit.resize(MAX_PROJECTILES);
+
+	sprite = {};
+	sprite.scale = 0.5;
+	sprite.shift = 0;
+	sprite.animationIndex = 0;
+}
+
+void ProjectilePool::remove(int index)
+{
+	count--;
+	posX[index] = posX[count];
+	posY[index] = posY[count];
+	velX[index] = velX[count];
+	velY[index] = velY[count];
+	timer[index] = timer[count];
+	damage[index] = damage[count];
+	hit[index] = hit[count];
+	grid.remove(count);
+	if (index != count) {
+		grid.update(index, { posX[index], posY[index] });
+	}
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "Point2D.h"
+#include "Animated.h"
+#include "Map.h"
+#include "Player.h"
+#include "SpatialGrid.h"
+#include "SaveState.h"
+
+#define MAX_PROJECTILES 1024
+#define PROJECTILE_SPEED 5
+#define PROJECTILE_TIME_LIMIT 10
+#define PROJECTILE_HIT_RADIUS 0.5
+
+/**
+ * @class ProjectilePool
+ * @brief Guarda todos los proyectiles de los enemigos en arreglos de capacidad fija.
+ *
+ * Los proyectiles activos ocupan las primeras `size()` posiciones de arreglos paralelos
+ * (posición, velocidad, tiempo de vida y daño) reservados una sola vez, así que disparar
+ * no reserva memoria. Todos comparten un mismo sprite animado.
+ */
+class ProjectilePool {
+public:
+    /**
+     * @brief Dispara un proyectil nuevo.
+     *
+     * @param position Posición inicial.
+     * @param angle Dirección en radianes.
+     * @param damage Daño que inflige al jugador.
+     * @return false si el arreglo está lleno y el disparo se descartó.
+     */
+    bool spawn(Point2D position, double angle, int damage);
+
+    /**
+     * @brief Mueve todos los proyectiles y resuelve sus choques en un solo recorrido.
+     *
+     * Un proyectil desaparece si alcanza al jugador (y le hace daño), si tiene una pared
+     * delante o si supera `PROJECTILE_TIME_LIMIT` segundos. Los que alcanzan al jugador
+     * se buscan en `grid` alrededor de él.
+     *
+     * @param player Jugador al que pueden alcanzar.
+     * @param map Mapa del nivel actual.
+     * @param deltaTime Duración del tick en segundos.
+     */
+    void update(Player& player, Map& map, double deltaTime);
+
+    /**
+     * @brief Elimina todos los proyectiles.
+     */
+    void clear();
+
+    /**
+     * @brief Cantidad de proyectiles activos.
+     * @return Número de proyectiles.
+     */
+    int size() const;
+
+    /**
+     * @brief Guarda los proyectiles activos y la animación compartida.
+     *
+     * @param out Destino.
+     */
+    void save(StateWriter& out);
+
+    /**
+     * @brief Reemplaza los proyectiles por los que guardó `save`.
+     *
+     * @param in Origen.
+     * @return false si faltaban datos.
+     */
+    bool load(StateReader& in);
+
+    /**
+     * @brief Posición de un proyectil activo.
+     *
+     * @param index Índice entre 0 y `size() - 1`.
+     * @return Posición en el mundo.
+     */
+    Point2D getPosition(int index) const;
+
+    /**
+     * @brief Posición de un proyectil activo al empezar el último tick.
+     *
+     * Los proyectiles avanzan en línea recta, así que se obtiene retrocediendo un tick
+     * con su velocidad; un proyectil recién disparado no retrocede.
+     *
+     * @param index Índice entre 0 y `size() - 1`.
+     * @return Posición en el mundo.
+     */
+    Point2D getPreviousPosition(int index) const;
+
+    /**
+     * @brief Sprite que comparten todos los proyectiles.
+     * @return Referencia al sprite.
+     */
+    Animated& getSprite();
+
+    /**
+     * @brief Reserva los arreglos y prepara el sprite compartido.
+     */
+    ProjectilePool();
+
+private:
+    int count;                  ///< Proyectiles activos.
+    std::vector<double> posX;   ///< Posición X de cada proyectil.
+    std::vector<double> posY;   ///< Posición Y de cada proyectil.
+    std::vector<double> velX;   ///< Velocidad X en celdas por segundo.
+    std::vector<double> velY;   ///< Velocidad Y en celdas por segundo.
+    std::vector<double> timer;  ///< Tiempo de vida transcurrido.
+    std::vector<int> damage;    ///< Daño al jugador.
+    std::vector<uint8_t> hit;   ///< 1 si el proyectil alcanzó al jugador en este tick.
+    SpatialGrid grid;           ///< Índice espacial de los proyectiles, por índice.
+    std::vector<int> nearby;    ///< Resultados de las consultas a `grid`, reutilizados.
+    Animated sprite;            ///< Sprite animado compartido.
+
+    /**
+     * @brief Elimina un proyectil moviendo el último a su lugar.
+     *
+     * @param index Índice del proyectil a eliminar.
+     */
+    void remove(int index);
+};
@@ -42,7 +42,7 @@ public:
      * @param map Referencia al mapa donde se realiza el raycasting.
      * @return Una estructura `RayCastResult` con la informacin del impacto del rayo.
      */
-    RayCastResult rayCast(double angle, Point2D position, Map& map);
+    RayCastResult rayCast(double angle, Point2D position, const Map& map);
 
     /**
      * @brief Obtiene todos los rayos en un rango de ngulo.
@@ -55,7 +55,7 @@ public:
      * @param map Referencia al mapa donde se realiza el raycasting.
      * @return Un vector de `RayCastResult` con informacin de cada rayo lanzado.
      */
-    std::vector<RayCastResult> getAllRays(double rayAngle, Player player, Map map);
+    std::vector<RayCastResult> getAllRays(double rayAngle, Player player, const Map& map);
 
     /**
      * @brief Obtiene el ngulo entre rayos consecutivos.
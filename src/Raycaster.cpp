@@ -3,7 +3,7 @@
 #include <iostream>
 #include "RayCaster.h"
 
-RayCastResult RayCaster::rayCast(double angle, Point2D position, Map& map)
+RayCastResult RayCaster::rayCast(double angle, Point2D position, const Map& map)
 {
 	IPoint2D gridPos = { 0,0 };
 	int maxDepth = GRID_SIZE;
@@ -52,7 +52,7 @@ RayCastResult RayCaster::rayCast(double angle, Point2D position, Map& map)
 	return getShortest(xNearest, yNearest);
 }
 
-std::vector<RayCastResult> RayCaster::getAllRays(double rayAngle, Player player, Map map)
+std::vector<RayCastResult> RayCaster::getAllRays(double rayAngle, Player player, const Map& map)
 {
 	RayCastResult hit;
 	for (int ray = 0; ray < numRays; ray++) {
@@ -159,22 +159,23 @@ Point2D RayCaster::calculateYStep(double angle, double& yStepLength)
 RayCastResult RayCaster::getShortest(RayCastResult xNearest, RayCastResult yNearest)
 {
 	if (std::abs(xNearest.depth) < std::abs(yNearest.depth)) {
-		xNearest.hitCoordinates.y = fmod(xNearest.hitCoordinates.y, 1);
+		//hitCoordinates stays in world space, the lightmap is sampled there
+		float offset = fmod(xNearest.hitCoordinates.y, 1);
 		if (xNearest.cos > 0) {
-			xNearest.horizontalTextureOffset = xNearest.hitCoordinates.y;
+			xNearest.horizontalTextureOffset = offset;
 		}
 		else {
-			xNearest.horizontalTextureOffset = 1 - xNearest.hitCoordinates.y;
+			xNearest.horizontalTextureOffset = 1 - offset;
 		}
 		return xNearest;
 	}
 	else {
-		yNearest.hitCoordinates.x = fmod(yNearest.hitCoordinates.x, 1);
+		float offset = fmod(yNearest.hitCoordinates.x, 1);
 		if (yNearest.cos > 0) {
-			yNearest.horizontalTextureOffset = 1 - yNearest.hitCoordinates.x;
+			yNearest.horizontalTextureOffset = 1 - offset;
 		}
 		else {
-			yNearest.horizontalTextureOffset = yNearest.hitCoordinates.x;
+			yNearest.horizontalTextureOffset = offset;
 		}
 		return yNearest;
 	}
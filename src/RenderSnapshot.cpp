@@ -0,0 +1,98 @@
+#include <cmath>
+#include "RenderSnapshot.h"
+#include "AnimationSystem.h"
+#include "GameClock.h"
+
+void RenderSnapshot::capture(const Player& player, const Map& map, ItemManager& items, EnemyManager& enemies)
+{
+	//copies keep pointing at this snapshot's own weapon, never at the simulated one
+	this->player = player;
+	weapon = *player.weapon;
+	weaponSprite = *player.weapon->sprite;
+	weaponSprite.currentFrame = AnimationSystem::getInstance()->getFrame(*player.weapon->sprite);
+	weapon.sprite = &weaponSprite;
+	this->player.weapon = &weapon;
+	this->map.copyCells(map);
+	time = GameClock::getInstance()->getTime();
+	playerPosition = player.position;
+	playerAngle = player.angle;
+
+	staticCount = 0;
+	animatedCount = 0;
+	for (auto item : *items.getCurrentItemList()) {
+		addSprite(item->sprite, item->position, item->position);
+	}
+	EnemyStore* store = enemies.getEnemies();
+	for (int i = 0; i < store->size(); i++) {
+		addSprite(&store->sprite[i], store->position[i], store->previousPosition[i]);
+	}
+	ProjectilePool* projectiles = enemies.getProjectiles();
+	for (int i = 0; i < projectiles->size(); i++) {
+		addSprite(&projectiles->getSprite(), projectiles->getPosition(i), projectiles->getPreviousPosition(i));
+	}
+	staticSprites.resize(staticCount);
+	animatedSprites.resize(animatedCount);
+	previousPositions.resize(animatedCount);
+	currentPositions.resize(animatedCount);
+}
+
+void RenderSnapshot::interpolate(double alpha)
+{
+	player.position.x = player.previousPosition.x + (playerPosition.x - player.previousPosition.x) * alpha;
+	player.position.y = player.previousPosition.y + (playerPosition.y - player.previousPosition.y) * alpha;
+
+	//the angle wraps around at 2 PI, turn the short way
+	double turn = remainder(playerAngle - player.previousAngle, 2 * PI);
+	player.angle = player.previousAngle + turn * alpha;
+	if (player.angle < 0) {
+		player.angle += 2 * PI;
+	}
+	else if (player.angle > 2 * PI) {
+		player.angle -= 2 * PI;
+	}
+
+	for (int i = 0; i < animatedCount; i++) {
+		Point2D previous = previousPositions[i];
+		Point2D current = currentPositions[i];
+		animatedSprites[i].position.x = previous.x + (current.x - previous.x) * alpha;
+		animatedSprites[i].position.y = previous.y + (current.y - previous.y) * alpha;
+	}
+}
+
+void RenderSnapshot::addSprite(Drawable* sprite, Point2D position, Point2D previous)
+{
+	Animated* animated = dynamic_cast<Animated*>(sprite);
+	if (animated) {
+		if (animatedCount == (int)animatedSprites.size()) {
+			animatedSprites.emplace_back();
+			previousPositions.emplace_back();
+			currentPositions.emplace_back();
+		}
+		previousPositions[animatedCount] = previous;
+		currentPositions[animatedCount] = position;
+		animatedSprites[animatedCount] = *animated;
+		animatedSprites[animatedCount].position = position;
+		animatedSprites[animatedCount].currentFrame = AnimationSystem::getInstance()->getFrame(*animated);
+		animatedCount++;
+	}
+	else if (sprite) {
+		if (staticCount == (int)staticSprites.size()) {
+			staticSprites.emplace_back();
+		}
+		staticSprites[staticCount] = *sprite;
+		staticSprites[staticCount].position = position;
+		staticCount++;
+	}
+}
+
+RenderSnapshot::RenderSnapshot(const Player& player, const Map& map)
+	: player(player), weapon(*player.weapon), weaponSprite(*player.weapon->sprite), map(map.createSnapshot())
+{
+	weapon.sprite = &weaponSprite;
+	this->player.weapon = &weapon;
+	staticCount = 0;
+	animatedCount = 0;
+	time = 0;
+	playerPosition = player.position;
+	playerAngle = player.angle;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <vector>
+#include "Player.h"
+#include "Weapon.h"
+#include "Map.h"
+#include "Drawable.h"
+#include "Animated.h"
+#include "ItemManager.h"
+#include "EnemyManager.h"
+
+/**
+ * @class RenderSnapshot
+ * @brief Copia inmutable del estado del juego que necesita el dibujo de un cuadro.
+ *
+ * La simulación la llena al final de cada tick y el hilo principal la dibuja sin tocar
+ * los objetos que la simulación está modificando. Contiene copias del jugador y su arma,
+ * de la cuadrícula del mapa y de todos los sprites del mundo.
+ * Guarda además dónde estaban el jugador y los sprites al empezar el tick, para que el
+ * dibujo pueda interpolar entre dos ticks de paso fijo con `interpolate`.
+ */
+class RenderSnapshot {
+public:
+    Player player;                        ///< Copia del jugador; su `weapon` apunta a `weapon`.
+    Weapon weapon;                        ///< Copia del arma; su `sprite` apunta a `weaponSprite`.
+    Animated weaponSprite;                ///< Copia del sprite del arma.
+    Map map;                              ///< Copia independiente del nivel actual.
+    std::vector<Drawable> staticSprites;  ///< Sprites sin animación (cajas de munición y salud).
+    std::vector<Animated> animatedSprites; ///< Sprites animados (lámparas, enemigos y proyectiles).
+    double time;                          ///< Tiempo de la simulación al final del tick capturado.
+
+    /**
+     * @brief Copia el estado actual del juego en la instantánea.
+     *
+     * Reutiliza la memoria de las copias anteriores para no reservar en cada tick.
+     *
+     * @param player Jugador.
+     * @param map Mapa del nivel actual.
+     * @param items Gestor de ítems.
+     * @param enemies Gestor de enemigos.
+     */
+    void capture(const Player& player, const Map& map, ItemManager& items, EnemyManager& enemies);
+
+    /**
+     * @brief Ubica al jugador y los sprites animados entre el tick anterior y el capturado.
+     *
+     * Puede llamarse varias veces sobre la misma instantánea: siempre parte de las
+     * posiciones capturadas.
+     *
+     * @param alpha Fracción del tick, de 0 (inicio del tick) a 1 (estado capturado).
+     */
+    void interpolate(double alpha);
+
+    /**
+     * @brief Crea una instantánea inicial a partir del jugador y el mapa.
+     *
+     * @param player Jugador del que se copian los datos iniciales.
+     * @param map Mapa del que se crea la copia independiente.
+     */
+    RenderSnapshot(const Player& player, const Map& map);
+
+private:
+    int staticCount;   ///< Sprites estáticos válidos en este tick.
+    int animatedCount; ///< Sprites animados válidos en este tick.
+    Point2D playerPosition; ///< Posición capturada del jugador.
+    double playerAngle;     ///< Ángulo capturado del jugador.
+    std::vector<Point2D> previousPositions; ///< Posición de cada sprite animado al empezar el tick.
+    std::vector<Point2D> currentPositions;  ///< Posición capturada de cada sprite animado.
+
+    /**
+     * @brief Agrega la copia de un sprite a la lista que le corresponde.
+     *
+     * @param sprite Sprite del mundo.
+     * @param position Posición de la entidad dueña del sprite.
+     * @param previous Posición de la entidad al empezar el tick.
+     */
+    void addSprite(Drawable* sprite, Point2D position, Point2D previous);
+};
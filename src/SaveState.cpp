@@ -0,0 +1,52 @@
+#include "SaveState.h"
+
+size_t StateWriter::size() const
+{
+	return buffer.size();
+}
+
+StateWriter::StateWriter(std::vector<uint8_t>& buffer) : buffer(buffer)
+{
+	buffer.clear();
+}
+
+void StateWriter::append(const void* data, size_t size)
+{
+	if (size == 0) {
+		return;
+	}
+	size_t offset = buffer.size();
+	buffer.resize(offset + size);
+	memcpy(buffer.data() + offset, data, size);
+}
+
+bool StateReader::isValid() const
+{
+	return valid;
+}
+
+size_t StateReader::remaining() const
+{
+	return length - cursor;
+}
+
+StateReader::StateReader(const std::vector<uint8_t>& buffer)
+{
+	data = buffer.data();
+	length = buffer.size();
+	cursor = 0;
+	valid = true;
+}
+
+bool StateReader::take(void* destination, size_t size)
+{
+	if (!valid || size > remaining()) {
+		valid = false;
+		return false;
+	}
+	if (size > 0) {
+		memcpy(destination, data + cursor, size);
+	}
+	cursor += size;
+	return true;
+}
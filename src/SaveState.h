@@ -0,0 +1,178 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#define SAVE_MAGIC 0x45564153
+#define SAVE_VERSION 2
+#define QUICKSAVE_FILE "quicksave.sav"
+
+/**
+ * @struct SaveHeader
+ * @brief Cabecera de una partida guardada.
+ */
+struct SaveHeader {
+    uint32_t magic;   ///< `SAVE_MAGIC`, para reconocer el archivo.
+    uint32_t version; ///< `SAVE_VERSION` con la que se guardó.
+    uint32_t size;    ///< Tamaño total en bytes, cabecera incluida.
+};
+
+/**
+ * @class StateWriter
+ * @brief Escribe el estado de la simulación como bytes seguidos, sin separadores.
+ *
+ * Escribe en un búfer que le presta quien guarda, así que guardar varias veces reutiliza
+ * la misma memoria. Los valores se copian tal cual están en memoria; los arreglos se
+ * copian enteros de una vez.
+ */
+class StateWriter {
+public:
+    /**
+     * @brief Agrega un valor.
+     *
+     * @param value Valor a escribir.
+     */
+    template <typename T>
+    void write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "solo se guardan valores copiables");
+        append(&value, sizeof(T));
+    }
+
+    /**
+     * @brief Agrega `count` valores seguidos, sin su cantidad.
+     *
+     * @param values Primer valor.
+     * @param count Cantidad de valores.
+     */
+    template <typename T>
+    void writeBlock(const T* values, int count)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "solo se guardan valores copiables");
+        append(values, sizeof(T) * count);
+    }
+
+    /**
+     * @brief Agrega la cantidad de elementos de un arreglo y luego sus elementos.
+     *
+     * @param values Arreglo a escribir.
+     */
+    template <typename T>
+    void writeArray(const std::vector<T>& values)
+    {
+        write<int32_t>(values.size());
+        writeBlock(values.data(), values.size());
+    }
+
+    /**
+     * @brief Cantidad de bytes escritos hasta ahora.
+     * @return Tamaño del búfer.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Construye un escritor que vacía `buffer` y escribe en él.
+     *
+     * @param buffer Búfer de destino; conserva su capacidad.
+     */
+    explicit StateWriter(std::vector<uint8_t>& buffer);
+
+private:
+    std::vector<uint8_t>& buffer; ///< Bytes escritos.
+
+    /**
+     * @brief Copia bytes al final del búfer.
+     *
+     * @param data Bytes a copiar.
+     * @param size Cantidad de bytes.
+     */
+    void append(const void* data, size_t size);
+};
+
+/**
+ * @class StateReader
+ * @brief Lee en el mismo orden lo que escribió un `StateWriter`.
+ *
+ * Si se intenta leer más allá del final, la lectura falla y el lector queda inválido.
+ */
+class StateReader {
+public:
+    /**
+     * @brief Lee un valor.
+     *
+     * @param value Recibe el valor.
+     * @return false si no quedaban bytes suficientes.
+     */
+    template <typename T>
+    bool read(T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "solo se leen valores copiables");
+        return take(&value, sizeof(T));
+    }
+
+    /**
+     * @brief Lee `count` valores seguidos.
+     *
+     * @param values Donde se copian; debe tener lugar para `count` valores.
+     * @param count Cantidad de valores.
+     * @return false si no quedaban bytes suficientes.
+     */
+    template <typename T>
+    bool readBlock(T* values, int count)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "solo se leen valores copiables");
+        return take(values, sizeof(T) * count);
+    }
+
+    /**
+     * @brief Lee un arreglo escrito con `StateWriter::writeArray`, cambiando su tamaño.
+     *
+     * @param values Arreglo de destino.
+     * @return false si no quedaban bytes suficientes.
+     */
+    template <typename T>
+    bool readArray(std::vector<T>& values)
+    {
+        int32_t count;
+        if (!read(count) || count < 0 || (size_t)count * sizeof(T) > remaining()) {
+            valid = false;
+            return false;
+        }
+        values.resize(count);
+        return readBlock(values.data(), count);
+    }
+
+    /**
+     * @brief Indica si todas las lecturas hasta ahora tuvieron éxito.
+     * @return false si alguna lectura se pasó del final.
+     */
+    bool isValid() const;
+
+    /**
+     * @brief Cantidad de bytes que quedan por leer.
+     * @return Bytes restantes.
+     */
+    size_t remaining() const;
+
+    /**
+     * @brief Construye un lector sobre un búfer, desde el principio.
+     *
+     * @param buffer Bytes a leer; deben seguir existiendo mientras se lee.
+     */
+    explicit StateReader(const std::vector<uint8_t>& buffer);
+
+private:
+    const uint8_t* data; ///< Bytes a leer.
+    size_t length;       ///< Cantidad total de bytes.
+    size_t cursor;       ///< Posición del próximo byte a leer.
+    bool valid;          ///< false después de una lectura fallida.
+
+    /**
+     * @brief Copia bytes desde la posición actual.
+     *
+     * @param destination Donde se copian.
+     * @param size Cantidad de bytes.
+     * @return false si no quedaban bytes suficientes.
+     */
+    bool take(void* destination, size_t size);
+};
@@ -0,0 +1,125 @@
+#include <utility>
+#include "SimulationThread.h"
+
+void SimulationThread::start(std::function<GameState(const InputFrame&)> tick, std::function<void(RenderSnapshot&)> capture)
+{
+	this->tick = tick;
+	this->capture = capture;
+	auto player = Player::getInstance();
+	auto map = Map::getInstance();
+	front = new RenderSnapshot(*player, *map);
+	ready = new RenderSnapshot(*player, *map);
+	back = new RenderSnapshot(*player, *map);
+	capture(*front);
+	running = true;
+	worker = std::thread(&SimulationThread::run, this);
+}
+
+void SimulationThread::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		running = false;
+		pending.clear();
+	}
+	inputReady.notify_all();
+	if (worker.joinable()) {
+		worker.join();
+	}
+	delete front;
+	delete ready;
+	delete back;
+	front = ready = back = nullptr;
+}
+
+void SimulationThread::submit(const InputFrame& input, bool publish)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	//backpressure: never let the simulation fall more than a couple of frames behind
+	tickDone.wait(lock, [this] { return pending.size() < MAX_PENDING_TICKS || !running; });
+	if (requestedState != na) {
+		//the game is leaving the playing state, how many ticks the main thread still sends depends on timing
+		return;
+	}
+	pending.push_back({ input, publish });
+	lock.unlock();
+	inputReady.notify_one();
+}
+
+void SimulationThread::waitIdle()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	tickDone.wait(lock, [this] { return (pending.empty() && !busy) || !running; });
+}
+
+void SimulationThread::publish()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	capture(*back);
+	std::swap(back, ready);
+	fresh = true;
+}
+
+RenderSnapshot& SimulationThread::getLatestSnapshot()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (fresh) {
+		std::swap(front, ready);
+		fresh = false;
+	}
+	return *front;
+}
+
+GameState SimulationThread::takeRequestedState()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	GameState state = requestedState;
+	requestedState = na;
+	return state;
+}
+
+SimulationThread::SimulationThread()
+{
+	running = false;
+	busy = false;
+	fresh = false;
+	requestedState = na;
+	front = nullptr;
+	ready = nullptr;
+	back = nullptr;
+}
+
+void SimulationThread::run()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		inputReady.wait(lock, [this] { return !pending.empty() || !running; });
+		if (!running) {
+			break;
+		}
+		PendingTick next = pending.front();
+		pending.pop_front();
+		busy = true;
+		lock.unlock();
+
+		//the tick and the capture touch only game state and the back snapshot
+		GameState state = tick(next.input);
+		bool publish = next.publish || state != na;
+		if (publish) {
+			capture(*back);
+		}
+
+		lock.lock();
+		if (publish) {
+			std::swap(back, ready);
+			fresh = true;
+		}
+		busy = false;
+		if (state != na && requestedState == na) {
+			//the game is leaving the playing state, input queued after this tick no longer applies
+			requestedState = state;
+			pending.clear();
+		}
+		tickDone.notify_all();
+	}
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include "InputFrame.h"
+#include "RenderSnapshot.h"
+#include "Enumerations.h"
+#include "GameClock.h"
+#define MAX_PENDING_TICKS (2 * MAX_TICKS_PER_FRAME)
+
+/**
+ * @class SimulationThread
+ * @brief Ejecuta la lógica del juego en un hilo propio, en paralelo con el dibujo.
+ *
+ * El hilo principal encola con `submit` la entrada de cada tick de paso fijo que le toca
+ * al cuadro; el hilo de simulación procesa los ticks en orden y publica una
+ * `RenderSnapshot` al terminar el último tick de cada cuadro.
+ * Hay tres instantáneas que rotan (una que se dibuja, la última publicada y otra que se
+ * está llenando), así que ninguno de los dos hilos espera al otro mientras el trabajo
+ * de ambos quepa en un cuadro: el tiempo por cuadro tiende a max(simulación, dibujo).
+ * Si la simulación se atrasa más de `MAX_PENDING_TICKS` ticks, `submit` espera.
+ */
+class SimulationThread {
+public:
+    /**
+     * @struct PendingTick
+     * @brief Tick encolado para la simulación.
+     */
+    struct PendingTick {
+        InputFrame input; ///< Entrada del tick.
+        bool publish;     ///< true si al terminar el tick se publica una instantánea.
+    };
+
+    /**
+     * @brief Crea las instantáneas y arranca el hilo de simulación.
+     *
+     * @param tick Función que simula un tick y devuelve el estado que pide la simulación (`na` si ninguno).
+     * @param capture Función que copia el estado del juego en una instantánea.
+     */
+    void start(std::function<GameState(const InputFrame&)> tick, std::function<void(RenderSnapshot&)> capture);
+
+    /**
+     * @brief Detiene el hilo, descartando las entradas pendientes.
+     */
+    void stop();
+
+    /**
+     * @brief Encola un tick para simularlo.
+     *
+     * Mientras haya un cambio de estado sin tomar con `takeRequestedState`, el tick se
+     * descarta sin simularlo.
+     *
+     * @param input Entrada del tick, muestreada en el hilo principal.
+     * @param publish true si es el último tick del cuadro y hay que publicar su instantánea.
+     */
+    void submit(const InputFrame& input, bool publish);
+
+    /**
+     * @brief Espera a que la simulación termine todas las entradas encoladas.
+     *
+     * Después de esta llamada el hilo principal puede modificar el estado del juego
+     * (cambiar de nivel, reiniciar) sin competir con la simulación.
+     */
+    void waitIdle();
+
+    /**
+     * @brief Captura y publica una instantánea desde el hilo que llama.
+     *
+     * Solo debe llamarse con la simulación detenida (ver `waitIdle`), por ejemplo al
+     * empezar un nivel, para no dibujar una instantánea vieja.
+     */
+    void publish();
+
+    /**
+     * @brief Obtiene la instantánea más reciente para dibujarla.
+     *
+     * La referencia sigue siendo válida hasta la siguiente llamada.
+     * @return Instantánea a dibujar.
+     */
+    RenderSnapshot& getLatestSnapshot();
+
+    /**
+     * @brief Devuelve y limpia el cambio de estado pedido por la simulación.
+     *
+     * Cuando la simulación pide salir de `playing` descarta las entradas que queden.
+     * @return El estado pedido, o `na` si no hubo ninguno.
+     */
+    GameState takeRequestedState();
+
+    /**
+     * @brief Constructor por defecto; el hilo no arranca hasta `start`.
+     */
+    SimulationThread();
+
+private:
+    std::thread worker;                       ///< Hilo de simulación.
+    std::mutex mutex;                         ///< Protege la cola, las instantáneas y el estado pedido.
+    std::condition_variable inputReady;       ///< Avisa al hilo de simulación que hay entrada.
+    std::condition_variable tickDone;         ///< Avisa al hilo principal que se procesó una entrada.
+    std::deque<PendingTick> pending;          ///< Ticks que faltan simular.
+    bool running;                             ///< false para pedir al hilo que termine.
+    bool busy;                                ///< true mientras se simula un tick.
+    bool fresh;                               ///< true si `ready` tiene una instantánea sin dibujar.
+    GameState requestedState;                 ///< Primer cambio de estado pedido por la simulación.
+    RenderSnapshot* front;                    ///< Instantánea que dibuja el hilo principal.
+    RenderSnapshot* ready;                    ///< Última instantánea publicada.
+    RenderSnapshot* back;                     ///< Instantánea que llena la simulación.
+    std::function<GameState(const InputFrame&)> tick;    ///< Lógica de un tick.
+    std::function<void(RenderSnapshot&)> capture;       ///< Copia del estado en una instantánea.
+
+    /**
+     * @brief Bucle del hilo de simulación.
+     */
+    void run();
+};
@@ -0,0 +1,427 @@
+#include <cmath>
+#include <algorithm>
+#include "SoftwareRenderer.h"
+#include "TextureManager.h"
+
+#ifdef SOFTWARE_RENDERER_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+void SoftwareRenderer::init(int width, int height)
+{
+	if (isReady() && this->width == width && this->height == height) {
+		return;
+	}
+	if (frameTexture.id != 0) {
+		UnloadTexture(frameTexture);
+	}
+	this->width = width;
+	this->height = height;
+	frameBuffer.assign(width * height, 0);
+	uploadBuffer.assign(width * height, 0);
+
+	Image blank = GenImageColor(width, height, BLANK);
+	frameTexture = LoadTextureFromImage(blank);
+	UnloadImage(blank);
+	SetTextureFilter(frameTexture, TEXTURE_FILTER_POINT);
+}
+
+void SoftwareRenderer::unload()
+{
+	if (frameTexture.id != 0) {
+		UnloadTexture(frameTexture);
+	}
+	frameTexture = {};
+	frameBuffer.clear();
+	uploadBuffer.clear();
+	columnTextures.clear();
+	width = 0;
+	height = 0;
+}
+
+bool SoftwareRenderer::isReady()
+{
+	return frameTexture.id != 0 && !frameBuffer.empty();
+}
+
+void SoftwareRenderer::loadTextures(const std::vector<Texture>& textures)
+{
+	for (auto& texture : textures) {
+		getColumnMips(texture);
+	}
+}
+
+void SoftwareRenderer::beginFrame(double darkness)
+{
+	if (darkness != shadeDarkness || shadeTable.empty()) {
+		buildShadeTable(darkness);
+	}
+	//transparent pixels let the background drawn underneath show through
+	std::fill(frameBuffer.begin(), frameBuffer.end(), 0);
+	frameOpen = true;
+}
+
+void SoftwareRenderer::endFrame(Rectangle dest)
+{
+	//transpose the column-major framebuffer into rows, in cache sized blocks
+	const int block = 16;
+	for (int x0 = 0; x0 < width; x0 += block) {
+		int x1 = std::min(x0 + block, width);
+		for (int y0 = 0; y0 < height; y0 += block) {
+			int y1 = std::min(y0 + block, height);
+			for (int x = x0; x < x1; x++) {
+				const uint32_t* column = &frameBuffer[x * height];
+				for (int y = y0; y < y1; y++) {
+					uploadBuffer[y * width + x] = column[y];
+				}
+			}
+		}
+	}
+	UpdateTexture(frameTexture, uploadBuffer.data());
+	Rectangle source = { 0, 0, (float)width, (float)height };
+	DrawTexturePro(frameTexture, source, dest, { 0,0 }, 0, WHITE);
+	frameOpen = false;
+}
+
+bool SoftwareRenderer::isFrameOpen()
+{
+	return frameOpen;
+}
+
+void SoftwareRenderer::setView(Point2D position, double angle, double firstRayAngle, double deltaAngle, double screenDist,
+                               WallType** floor, WallType** ceiling, const LightMap* lights)
+{
+	lightMap = lights;
+	viewX = (float)position.x;
+	viewY = (float)position.y;
+	floorGrid = floor;
+	ceilingGrid = ceiling;
+
+	//rows at the same distance from the horizon see the floor and ceiling at the same depth
+	rowDistance.resize(height);
+	rowShade.resize(height);
+	rowFootprint.resize(height);
+	for (int y = 0; y < height; y++) {
+		double rowsFromHorizon = std::max(0.5, std::abs(y + 0.5 - height / 2.0));
+		rowDistance[y] = (float)(screenDist / (2 * rowsFromHorizon));
+		rowShade[y] = (uint16_t)getShade(rowDistance[y]);
+		rowFootprint[y] = (float)(rowDistance[y] / screenDist);
+	}
+
+	//columns are spaced by angle, so each one steps by its own direction per unit of depth
+	columnDirX.resize(width);
+	columnDirY.resize(width);
+	for (int x = 0; x < width; x++) {
+		double rayAngle = firstRayAngle + x * deltaAngle;
+		double correction = cos(rayAngle - angle);
+		columnDirX[x] = (float)(cos(rayAngle) / correction);
+		columnDirY[x] = (float)(sin(rayAngle) / correction);
+	}
+}
+
+void SoftwareRenderer::setSurfaceTextures(const std::vector<Texture>& textures)
+{
+	surfaceTextures.assign(textures.size(), nullptr);
+	for (int i = 0; i < (int)textures.size(); i++) {
+		if (i != none && textures[i].id != 0) {
+			surfaceTextures[i] = &getColumnMips(textures[i]);
+		}
+	}
+}
+
+void SoftwareRenderer::drawWallColumn(Texture texture, int column, float textureOffset, double projectionHeight, double depth, int light)
+{
+	if (column < 0 || column >= width || projectionHeight <= 0) {
+		return;
+	}
+	//the level is chosen from the projected height, so far walls read a small contiguous column
+	const ColumnTexture& tex = selectMip(getColumnMips(texture), texture.height / projectionHeight);
+	int texX = std::clamp((int)(textureOffset * tex.width), 0, tex.width - 1);
+
+	double top = height / 2.0 - projectionHeight / 2;
+	int yStart = std::max(0, (int)std::ceil(top));
+	int yEnd = std::min(height, (int)std::ceil(top + projectionHeight));
+	castSurface(column, 0, yStart, ceilingGrid);
+	castSurface(column, yEnd, height, floorGrid);
+	if (yStart >= yEnd) {
+		return;
+	}
+	float dv = (float)(tex.height / projectionHeight);
+	float v = (float)((yStart + 0.5 - top) * dv);
+	int shade = std::min(256, getShade(depth) + light + (light >> 7));
+	int tint[3] = { shade, shade, shade };
+	sampleColumn(&tex.texels[texX * tex.height], tex.height, &frameBuffer[column * height + yStart], yEnd - yStart, v, dv, tint, false);
+}
+
+void SoftwareRenderer::drawSprite(Texture texture, Rectangle source, Rectangle dest, Color tint)
+{
+	if (dest.width <= 0 || dest.height <= 0) {
+		return;
+	}
+	int xStart = std::max(0, (int)std::ceil(dest.x));
+	int xEnd = std::min(width, (int)std::ceil(dest.x + dest.width));
+	int yStart = std::max(0, (int)std::ceil(dest.y));
+	int yEnd = std::min(height, (int)std::ceil(dest.y + dest.height));
+	if (xStart >= xEnd || yStart >= yEnd) {
+		return;
+	}
+	const ColumnTexture& tex = selectMip(getColumnMips(texture), source.height / dest.height);
+	//the source rectangle is given in level 0 texels
+	float ratioX = (float)tex.width / std::max(1, texture.width);
+	float ratioY = (float)tex.height / std::max(1, texture.height);
+	source = { source.x * ratioX, source.y * ratioY, source.width * ratioX, source.height * ratioY };
+	float du = source.width / dest.width;
+	float dv = source.height / dest.height;
+	float v = source.y + (yStart + 0.5f - dest.y) * dv;
+	int tintMul[3] = { tint.r + (tint.r >> 7), tint.g + (tint.g >> 7), tint.b + (tint.b >> 7) };
+	for (int x = xStart; x < xEnd; x++) {
+		float u = source.x + (x + 0.5f - dest.x) * du;
+		int texX = std::clamp((int)u, 0, tex.width - 1);
+		sampleColumn(&tex.texels[texX * tex.height], tex.height, &frameBuffer[x * height + yStart], yEnd - yStart, v, dv, tintMul, true);
+	}
+}
+
+int SoftwareRenderer::getShade(double depth)
+{
+	int index = (int)(depth * SHADE_TABLE_STEPS);
+	index = std::clamp(index, 0, (int)shadeTable.size() - 1);
+	return shadeTable[index];
+}
+
+int SoftwareRenderer::getWidth()
+{
+	return width;
+}
+
+int SoftwareRenderer::getHeight()
+{
+	return height;
+}
+
+SoftwareRenderer::SoftwareRenderer()
+{
+	width = 0;
+	height = 0;
+	frameOpen = false;
+	shadeDarkness = -1;
+	frameTexture = {};
+	viewX = 0;
+	viewY = 0;
+	floorGrid = nullptr;
+	ceilingGrid = nullptr;
+	lightMap = nullptr;
+}
+
+const std::vector<ColumnTexture>& SoftwareRenderer::getColumnMips(Texture texture)
+{
+	auto found = columnTextures.find(texture.id);
+	if (found != columnTextures.end()) {
+		return found->second;
+	}
+
+	Image image = LoadImageFromTexture(texture);
+	ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+	std::vector<ColumnTexture>& chain = columnTextures[texture.id];
+	chain.emplace_back();
+	ColumnTexture& decoded = chain.back();
+	decoded.width = std::max(1, image.width);
+	decoded.height = std::max(1, image.height);
+	decoded.texels.assign(decoded.width * decoded.height, 0);
+	const uint32_t* rows = (const uint32_t*)image.data;
+	if (rows) {
+		for (int y = 0; y < image.height; y++) {
+			for (int x = 0; x < image.width; x++) {
+				decoded.texels[x * decoded.height + y] = rows[y * image.width + x];
+			}
+		}
+	}
+	UnloadImage(image);
+
+	//same stopping size as the GPU chains built by the TextureManager
+	while (chain.back().width / 2 >= MIN_MIP_SIZE && chain.back().height / 2 >= MIN_MIP_SIZE) {
+		ColumnTexture level;
+		downsample(chain.back(), level);
+		chain.push_back(std::move(level));
+	}
+	return chain;
+}
+
+const ColumnTexture& SoftwareRenderer::selectMip(const std::vector<ColumnTexture>& chain, double texelsPerPixel)
+{
+	return chain[TextureManager::getMipLevelIndex(texelsPerPixel, chain.size())];
+}
+
+void SoftwareRenderer::downsample(const ColumnTexture& source, ColumnTexture& level)
+{
+	level.width = source.width / 2;
+	level.height = source.height / 2;
+	level.texels.assign(level.width * level.height, 0);
+	for (int x = 0; x < level.width; x++) {
+		const uint32_t* left = &source.texels[(2 * x) * source.height];
+		const uint32_t* right = &source.texels[(2 * x + 1) * source.height];
+		uint32_t* dst = &level.texels[x * level.height];
+		for (int y = 0; y < level.height; y++) {
+			uint32_t quad[4] = { left[2 * y], left[2 * y + 1], right[2 * y], right[2 * y + 1] };
+			//weight color by alpha so transparent sprite borders don't darken the edges
+			uint32_t r = 0, g = 0, b = 0, a = 0;
+			for (uint32_t texel : quad) {
+				uint32_t alpha = texel >> 24;
+				r += (texel & 0xFF) * alpha;
+				g += ((texel >> 8) & 0xFF) * alpha;
+				b += ((texel >> 16) & 0xFF) * alpha;
+				a += alpha;
+			}
+			if (a == 0) {
+				continue;
+			}
+			dst[y] = ((a / 4) << 24) | ((b / a) << 16) | ((g / a) << 8) | (r / a);
+		}
+	}
+}
+
+void SoftwareRenderer::buildShadeTable(double darkness)
+{
+	//same falloff the GPU path applies as a tint: 225 / (1 + depth^5 * darkness)
+	shadeTable.resize(SHADE_TABLE_MAX_DEPTH * SHADE_TABLE_STEPS);
+	for (int i = 0; i < (int)shadeTable.size(); i++) {
+		double depth = (double)i / SHADE_TABLE_STEPS;
+		int color = (int)(225 / (1 + pow(depth, 5) * darkness));
+		shadeTable[i] = (uint16_t)(color + (color >> 7));
+	}
+	shadeDarkness = darkness;
+}
+
+void SoftwareRenderer::castSurface(int column, int yStart, int yEnd, WallType** grid)
+{
+	if (!grid || yStart >= yEnd) {
+		return;
+	}
+	float dirX = columnDirX[column];
+	float dirY = columnDirY[column];
+	uint32_t* dst = &frameBuffer[column * height];
+	alignas(16) float worldX[SURFACE_BATCH];
+	alignas(16) float worldY[SURFACE_BATCH];
+	alignas(16) uint32_t texels[SURFACE_BATCH];
+	alignas(16) uint16_t shades[SURFACE_BATCH];
+	const uint8_t* lights = lightMap ? lightMap->getCells() : nullptr;
+	int lightResolution = lightMap ? lightMap->getResolution() : 0;
+
+	for (int y0 = yStart; y0 < yEnd; y0 += SURFACE_BATCH) {
+		int count = std::min(SURFACE_BATCH, yEnd - y0);
+		const float* distance = &rowDistance[y0];
+		for (int k = 0; k < count; k++) {
+			worldX[k] = viewX + distance[k] * dirX;
+			worldY[k] = viewY + distance[k] * dirY;
+		}
+		for (int k = 0; k < count; k++) {
+			texels[k] = 0;
+			shades[k] = rowShade[y0 + k];
+			if (worldX[k] < 0 || worldY[k] < 0 || worldX[k] >= GRID_SIZE || worldY[k] >= GRID_SIZE) {
+				continue;
+			}
+			int cellX = (int)worldX[k];
+			int cellY = (int)worldY[k];
+			int id = grid[cellY][cellX];
+			const std::vector<ColumnTexture>* chain = id < (int)surfaceTextures.size() ? surfaceTextures[id] : nullptr;
+			if (!chain) {
+				continue;
+			}
+			const ColumnTexture* tex = &selectMip(*chain, rowFootprint[y0 + k] * chain->front().width);
+			int texX = std::min((int)((worldX[k] - cellX) * tex->width), tex->width - 1);
+			int texY = std::min((int)((worldY[k] - cellY) * tex->height), tex->height - 1);
+			texels[k] = tex->texels[texX * tex->height + texY];
+			if (lights) {
+				int light = lights[(int)(worldY[k] * LIGHTMAP_SUBDIVISIONS) * lightResolution + (int)(worldX[k] * LIGHTMAP_SUBDIVISIONS)];
+				shades[k] = (uint16_t)std::min(256, shades[k] + light + (light >> 7));
+			}
+		}
+		shadeSpan(texels, shades, dst + y0, count);
+	}
+}
+
+void SoftwareRenderer::shadeSpan(const uint32_t* texels, const uint16_t* shades, uint32_t* dst, int count)
+{
+	int i = 0;
+#ifdef SOFTWARE_RENDERER_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 4 <= count; i += 4) {
+		__m128i px = _mm_loadu_si128((const __m128i*)(texels + i));
+		short s0 = (short)shades[i], s1 = (short)shades[i + 1], s2 = (short)shades[i + 2], s3 = (short)shades[i + 3];
+		__m128i mulLo = _mm_set_epi16(256, s1, s1, s1, 256, s0, s0, s0);
+		__m128i mulHi = _mm_set_epi16(256, s3, s3, s3, 256, s2, s2, s2);
+		__m128i lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(px, zero), mulLo), 8);
+		__m128i hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(px, zero), mulHi), 8);
+		__m128i shaded = _mm_packus_epi16(lo, hi);
+		__m128i opaque = _mm_srai_epi32(px, 31);
+		__m128i current = _mm_loadu_si128((const __m128i*)(dst + i));
+		shaded = _mm_or_si128(_mm_and_si128(opaque, shaded), _mm_andnot_si128(opaque, current));
+		_mm_storeu_si128((__m128i*)(dst + i), shaded);
+	}
+#endif
+	for (; i < count; i++) {
+		uint32_t texel = texels[i];
+		if ((texel >> 31) == 0) {
+			continue;
+		}
+		uint32_t shade = shades[i];
+		uint32_t r = ((texel & 0xFF) * shade) >> 8;
+		uint32_t g = (((texel >> 8) & 0xFF) * shade) >> 8;
+		uint32_t b = (((texel >> 16) & 0xFF) * shade) >> 8;
+		dst[i] = (texel & 0xFF000000) | (b << 16) | (g << 8) | r;
+	}
+}
+
+void SoftwareRenderer::sampleColumn(const uint32_t* texColumn, int texHeight, uint32_t* dst, int count,
+                                    float v, float dv, const int tint[3], bool alphaTest)
+{
+	int maxIndex = texHeight - 1;
+	int i = 0;
+#ifdef SOFTWARE_RENDERER_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i mul = _mm_set_epi16(256, (short)tint[2], (short)tint[1], (short)tint[0],
+	                                  256, (short)tint[2], (short)tint[1], (short)tint[0]);
+#ifdef __AVX2__
+	const __m128 steps = _mm_set_ps(3, 2, 1, 0);
+	const __m128 vdv = _mm_set1_ps(dv);
+	const __m128i vmax = _mm_set1_epi32(maxIndex);
+#endif
+	for (; i + 4 <= count; i += 4) {
+#ifdef __AVX2__
+		__m128 rows = _mm_add_ps(_mm_set1_ps(v + i * dv), _mm_mul_ps(steps, vdv));
+		__m128i index = _mm_min_epi32(_mm_cvttps_epi32(rows), vmax);
+		__m128i texels = _mm_i32gather_epi32((const int*)texColumn, index, 4);
+#else
+		alignas(16) uint32_t gathered[4];
+		for (int k = 0; k < 4; k++) {
+			int index = (int)(v + (i + k) * dv);
+			gathered[k] = texColumn[index < maxIndex ? index : maxIndex];
+		}
+		__m128i texels = _mm_load_si128((const __m128i*)gathered);
+#endif
+		__m128i lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(texels, zero), mul), 8);
+		__m128i hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(texels, zero), mul), 8);
+		__m128i shaded = _mm_packus_epi16(lo, hi);
+		if (alphaTest) {
+			//alpha is the top byte, so its high bit becomes a full lane mask
+			__m128i opaque = _mm_srai_epi32(texels, 31);
+			__m128i current = _mm_loadu_si128((const __m128i*)(dst + i));
+			shaded = _mm_or_si128(_mm_and_si128(opaque, shaded), _mm_andnot_si128(opaque, current));
+		}
+		_mm_storeu_si128((__m128i*)(dst + i), shaded);
+	}
+#endif
+	for (; i < count; i++) {
+		int index = (int)(v + i * dv);
+		uint32_t texel = texColumn[index < maxIndex ? index : maxIndex];
+		if (alphaTest && (texel >> 31) == 0) {
+			continue;
+		}
+		uint32_t r = ((texel & 0xFF) * tint[0]) >> 8;
+		uint32_t g = (((texel >> 8) & 0xFF) * tint[1]) >> 8;
+		uint32_t b = (((texel >> 16) & 0xFF) * tint[2]) >> 8;
+		dst[i] = (texel & 0xFF000000) | (b << 16) | (g << 8) | r;
+	}
+}
@@ -0,0 +1,258 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <raylib.h>
+#include "Point2D.h"
+#include "Map.h"
+#include "TextureManager.h"
+#include "LightMap.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SOFTWARE_RENDERER_SSE2
+#endif
+
+#define SHADE_TABLE_STEPS 16
+#define SHADE_TABLE_MAX_DEPTH 128
+#define SURFACE_BATCH 16
+
+/**
+ * @struct ColumnTexture
+ * @brief Copia en memoria principal de una textura, guardada por columnas.
+ *
+ * Los texeles de una misma columna son contiguos (`texels[x * height + y]`), de modo
+ * que muestrear una columna vertical de pared o de sprite recorre memoria secuencial.
+ * Cada nivel de mipmap se guarda como una `ColumnTexture` propia, ya transpuesta.
+ */
+struct ColumnTexture {
+    int width;                   /**< Ancho de la textura en texeles. */
+    int height;                  /**< Alto de la textura en texeles. */
+    std::vector<uint32_t> texels; /**< Texeles RGBA8 en orden columna-mayor. */
+};
+
+/**
+ * @class SoftwareRenderer
+ * @brief Backend de renderizado por CPU para la vista 3D.
+ *
+ * Rasteriza las columnas de pared y los sprites en un framebuffer en memoria principal
+ * (un píxel por rayo) y lo sube a la GPU con un único `UpdateTexture` por cuadro.
+ * Pensado para equipos sin GPU (por ejemplo Mesa llvmpipe), donde dibujar miles de
+ * quads por cuadro es mucho más lento que subir una sola textura.
+ */
+class SoftwareRenderer {
+public:
+    /**
+     * @brief Reserva el framebuffer y la textura de subida.
+     *
+     * @param width Ancho del framebuffer en píxeles (uno por rayo).
+     * @param height Alto del framebuffer en píxeles.
+     */
+    void init(int width, int height);
+
+    /**
+     * @brief Libera el framebuffer, la textura de subida y las texturas decodificadas.
+     */
+    void unload();
+
+    /**
+     * @brief Indica si el renderizador ya fue inicializado.
+     * @return true si existe un framebuffer válido.
+     */
+    bool isReady();
+
+    /**
+     * @brief Decodifica a memoria principal todas las texturas cargadas en VRAM.
+     *
+     * @param textures Texturas a decodificar, normalmente todas las del `TextureManager`.
+     */
+    void loadTextures(const std::vector<Texture>& textures);
+
+    /**
+     * @brief Comienza un cuadro: limpia el framebuffer y actualiza la tabla de iluminación.
+     *
+     * @param darkness Nivel de oscuridad actual del `Canvas`.
+     */
+    void beginFrame(double darkness);
+
+    /**
+     * @brief Termina el cuadro: sube el framebuffer y lo dibuja escalado en la ventana.
+     *
+     * @param dest Área de la ventana donde se dibuja la vista 3D.
+     */
+    void endFrame(Rectangle dest);
+
+    /**
+     * @brief Indica si hay un cuadro abierto entre `beginFrame` y `endFrame`.
+     * @return true si las llamadas de dibujo deben ir al framebuffer.
+     */
+    bool isFrameOpen();
+
+    /**
+     * @brief Configura la cámara del cuadro actual para proyectar suelo y techo.
+     *
+     * Precalcula la distancia y la iluminación de cada fila (constantes a lo largo de la fila)
+     * y la dirección en el mundo de cada columna. Debe llamarse después de `beginFrame`.
+     *
+     * @param position Posición del jugador.
+     * @param angle Ángulo del jugador en radianes.
+     * @param firstRayAngle Ángulo del rayo de la primera columna.
+     * @param deltaAngle Ángulo entre columnas consecutivas.
+     * @param screenDist Distancia a la pantalla en píxeles del framebuffer.
+     * @param floor Texturas de suelo por celda, o `nullptr` para no dibujar suelo.
+     * @param ceiling Texturas de techo por celda, o `nullptr` para no dibujar techo.
+     * @param lights Luz horneada de las lámparas, o `nullptr` para usar solo la oscuridad.
+     */
+    void setView(Point2D position, double angle, double firstRayAngle, double deltaAngle, double screenDist,
+                 WallType** floor, WallType** ceiling, const LightMap* lights);
+
+    /**
+     * @brief Asigna las texturas que corresponden a cada identificador de suelo o techo.
+     *
+     * @param textures Texturas indexadas por `WallType`; las de id 0 se tratan como vacías.
+     */
+    void setSurfaceTextures(const std::vector<Texture>& textures);
+
+    /**
+     * @brief Dibuja una columna de pared junto con el suelo y el techo visibles en esa columna.
+     *
+     * @param texture Textura de la pared.
+     * @param column Columna del framebuffer (índice del rayo).
+     * @param textureOffset Desplazamiento horizontal en la textura, entre 0 y 1.
+     * @param projectionHeight Alto proyectado de la pared en píxeles del framebuffer.
+     * @param depth Profundidad de la pared, usada para la tabla de iluminación.
+     * @param light Luz de las lámparas frente a la pared, en unidades de color.
+     */
+    void drawWallColumn(Texture texture, int column, float textureOffset, double projectionHeight, double depth, int light);
+
+    /**
+     * @brief Dibuja un sprite con prueba de transparencia.
+     *
+     * @param texture Textura del sprite.
+     * @param source Área de la textura a dibujar.
+     * @param dest Área de destino en píxeles del framebuffer.
+     * @param tint Color con el que se multiplica el sprite.
+     */
+    void drawSprite(Texture texture, Rectangle source, Rectangle dest, Color tint);
+
+    /**
+     * @brief Devuelve el factor de iluminación en punto fijo (0 a 256) para una profundidad.
+     *
+     * @param depth Profundidad en unidades del mundo.
+     * @return Multiplicador de iluminación, donde 256 equivale a 1.
+     */
+    int getShade(double depth);
+
+    /**
+     * @brief Ancho del framebuffer.
+     * @return Ancho en píxeles.
+     */
+    int getWidth();
+
+    /**
+     * @brief Alto del framebuffer.
+     * @return Alto en píxeles.
+     */
+    int getHeight();
+
+    /**
+     * @brief Constructor por defecto; no reserva memoria hasta `init`.
+     */
+    SoftwareRenderer();
+
+private:
+    int width;                                /**< Ancho del framebuffer. */
+    int height;                               /**< Alto del framebuffer. */
+    bool frameOpen;                           /**< Indica si hay un cuadro en curso. */
+    double shadeDarkness;                     /**< Oscuridad con la que se generó `shadeTable`. */
+    std::vector<uint32_t> frameBuffer;        /**< Framebuffer en orden columna-mayor. */
+    std::vector<uint32_t> uploadBuffer;       /**< Framebuffer transpuesto a filas para la subida. */
+    std::vector<uint16_t> shadeTable;         /**< Iluminación por profundidad en punto fijo. */
+    Texture frameTexture;                     /**< Textura de GPU donde se sube el framebuffer. */
+    std::unordered_map<unsigned int, std::vector<ColumnTexture>> columnTextures; /**< Cadenas de mipmaps decodificadas por id de GPU. */
+    std::vector<const std::vector<ColumnTexture>*> surfaceTextures; /**< Cadenas de suelo y techo indexadas por `WallType`. */
+    std::vector<float> rowDistance;           /**< Profundidad del suelo o techo visible en cada fila. */
+    std::vector<uint16_t> rowShade;           /**< Iluminación de cada fila, tomada de `shadeTable`. */
+    std::vector<float> rowFootprint;          /**< Unidades del mundo que cubre un píxel de cada fila. */
+    std::vector<float> columnDirX;            /**< Avance en X por unidad de profundidad de cada columna. */
+    std::vector<float> columnDirY;            /**< Avance en Y por unidad de profundidad de cada columna. */
+    float viewX;                              /**< Posición X de la cámara. */
+    float viewY;                              /**< Posición Y de la cámara. */
+    WallType** floorGrid;                     /**< Texturas de suelo del nivel actual. */
+    WallType** ceilingGrid;                   /**< Texturas de techo del nivel actual. */
+    const LightMap* lightMap;                 /**< Luz horneada del nivel actual. */
+
+    /**
+     * @brief Busca o decodifica la copia en memoria principal de una textura y sus mipmaps.
+     *
+     * El nivel 0 se decodifica desde la GPU y los siguientes se reducen a la mitad
+     * directamente en orden columna-mayor, hasta `MIN_MIP_SIZE`.
+     *
+     * @param texture Textura de GPU.
+     * @return Cadena de niveles por columnas, del más grande al más pequeño.
+     */
+    const std::vector<ColumnTexture>& getColumnMips(Texture texture);
+
+    /**
+     * @brief Elige el nivel de mipmap según la reducción en pantalla.
+     *
+     * @param chain Cadena de niveles.
+     * @param texelsPerPixel Texeles del nivel 0 que cubre cada píxel.
+     * @return El nivel elegido.
+     */
+    static const ColumnTexture& selectMip(const std::vector<ColumnTexture>& chain, double texelsPerPixel);
+
+    /**
+     * @brief Genera el siguiente nivel de mipmap promediando bloques de 2x2 texeles.
+     *
+     * El color se pondera por la transparencia para que los bordes de los sprites no se oscurezcan.
+     *
+     * @param source Nivel de origen.
+     * @param level Nivel de destino, con la mitad de ancho y de alto.
+     */
+    static void downsample(const ColumnTexture& source, ColumnTexture& level);
+
+    /**
+     * @brief Regenera la tabla de iluminación por profundidad.
+     *
+     * @param darkness Nivel de oscuridad.
+     */
+    void buildShadeTable(double darkness);
+
+    /**
+     * @brief Proyecta un tramo vertical de suelo o techo en una columna.
+     *
+     * Las posiciones en el mundo se calculan por lotes a partir de `rowDistance`,
+     * de modo que el compilador pueda vectorizarlas, y la iluminación se aplica con `shadeSpan`.
+     *
+     * @param column Columna del framebuffer.
+     * @param yStart Primera fila a dibujar.
+     * @param yEnd Fila siguiente a la última.
+     * @param grid Texturas por celda (suelo o techo).
+     */
+    void castSurface(int column, int yStart, int yEnd, WallType** grid);
+
+    /**
+     * @brief Ilumina texeles con un factor distinto por píxel y los escribe si son opacos.
+     *
+     * @param texels Texeles de origen.
+     * @param shades Factor de iluminación de cada píxel, en punto fijo de 0 a 256.
+     * @param dst Píxeles de destino.
+     * @param count Número de píxeles.
+     */
+    static void shadeSpan(const uint32_t* texels, const uint16_t* shades, uint32_t* dst, int count);
+
+    /**
+     * @brief Muestrea un tramo de columna de textura, lo ilumina y lo escribe en el framebuffer.
+     *
+     * @param texColumn Inicio de la columna de la textura.
+     * @param texHeight Alto de la textura.
+     * @param dst Primer píxel de destino (contiguo en el framebuffer).
+     * @param count Número de píxeles a escribir.
+     * @param v Coordenada vertical inicial en texeles.
+     * @param dv Avance vertical en texeles por píxel.
+     * @param tint Multiplicador por canal (r, g, b) en punto fijo de 0 a 256.
+     * @param alphaTest Si es true, los texeles transparentes no se escriben.
+     */
+    static void sampleColumn(const uint32_t* texColumn, int texHeight, uint32_t* dst, int count,
+                             float v, float dv, const int tint[3], bool alphaTest);
+};
@@ -0,0 +1,172 @@
+#include <cmath>
+#include <algorithm>
+#include "SpatialGrid.h"
+
+void SpatialGrid::insert(int id, Point2D position)
+{
+	if (id >= (int)cellOf.size()) {
+		next.resize(id + 1, -1);
+		previous.resize(id + 1, -1);
+		cellOf.resize(id + 1, -1);
+		positions.resize(id + 1);
+	}
+	if (cellOf[id] >= 0) {
+		update(id, position);
+		return;
+	}
+	positions[id] = position;
+	link(id, cellIndex(position));
+}
+
+void SpatialGrid::update(int id, Point2D position)
+{
+	if (id >= (int)cellOf.size() || cellOf[id] < 0) {
+		insert(id, position);
+		return;
+	}
+	positions[id] = position;
+	int cell = cellIndex(position);
+	if (cell != cellOf[id]) {
+		unlink(id);
+		link(id, cell);
+	}
+}
+
+void SpatialGrid::remove(int id)
+{
+	if (id < (int)cellOf.size() && cellOf[id] >= 0) {
+		unlink(id);
+	}
+}
+
+void SpatialGrid::clear()
+{
+	std::fill(cellHead.begin(), cellHead.end(), -1);
+	next.clear();
+	previous.clear();
+	cellOf.clear();
+	positions.clear();
+}
+
+void SpatialGrid::queryRadius(Point2D center, double radius, std::vector<int>& result) const
+{
+	int minColumn = std::max(0, (int)floor(center.x - radius));
+	int maxColumn = std::min(GRID_SIZE - 1, (int)floor(center.x + radius));
+	int minRow = std::max(0, (int)floor(center.y - radius));
+	int maxRow = std::min(GRID_SIZE - 1, (int)floor(center.y + radius));
+	double radiusSquared = radius * radius;
+	for (int row = minRow; row <= maxRow; row++) {
+		for (int column = minColumn; column <= maxColumn; column++) {
+			for (int id = cellHead[row * GRID_SIZE + column]; id >= 0; id = next[id]) {
+				double dx = positions[id].x - center.x;
+				double dy = positions[id].y - center.y;
+				if (dx * dx + dy * dy <= radiusSquared) {
+					result.push_back(id);
+				}
+			}
+		}
+	}
+}
+
+void SpatialGrid::querySegment(Point2D from, Point2D to, double radius, std::vector<int>& result) const
+{
+	//walk the cells crossed by the segment and remember them with their neighbours
+	std::vector<int>& cells = segmentCells;
+	cells.clear();
+	int reach = (int)ceil(radius);
+	int column = (int)floor(from.x);
+	int row = (int)floor(from.y);
+	int endColumn = (int)floor(to.x);
+	int endRow = (int)floor(to.y);
+	double dirX = to.x - from.x;
+	double dirY = to.y - from.y;
+	int stepX = dirX > 0 ? 1 : -1;
+	int stepY = dirY > 0 ? 1 : -1;
+	double deltaX = dirX != 0 ? std::abs(1 / dirX) : INFINITY;
+	double deltaY = dirY != 0 ? std::abs(1 / dirY) : INFINITY;
+	double sideX = dirX > 0 ? (column + 1 - from.x) * deltaX : (from.x - column) * deltaX;
+	double sideY = dirY > 0 ? (row + 1 - from.y) * deltaY : (from.y - row) * deltaY;
+	int steps = std::abs(endColumn - column) + std::abs(endRow - row);
+	for (int i = 0; i <= steps; i++) {
+		for (int r = row - reach; r <= row + reach; r++) {
+			for (int c = column - reach; c <= column + reach; c++) {
+				if (r >= 0 && r < GRID_SIZE && c >= 0 && c < GRID_SIZE) {
+					cells.push_back(r * GRID_SIZE + c);
+				}
+			}
+		}
+		if (sideX < sideY) {
+			sideX += deltaX;
+			column += stepX;
+		}
+		else {
+			sideY += deltaY;
+			row += stepY;
+		}
+	}
+	std::sort(cells.begin(), cells.end());
+	cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+	for (int cell : cells) {
+		collectNearSegment(cell, from, to, radius, result);
+	}
+}
+
+SpatialGrid::SpatialGrid()
+{
+	cellHead.assign(GRID_SIZE * GRID_SIZE, -1);
+}
+
+int SpatialGrid::cellIndex(Point2D position)
+{
+	int column = std::min(std::max((int)floor(position.x), 0), GRID_SIZE - 1);
+	int row = std::min(std::max((int)floor(position.y), 0), GRID_SIZE - 1);
+	return row * GRID_SIZE + column;
+}
+
+void SpatialGrid::link(int id, int cell)
+{
+	previous[id] = -1;
+	next[id] = cellHead[cell];
+	if (cellHead[cell] >= 0) {
+		previous[cellHead[cell]] = id;
+	}
+	cellHead[cell] = id;
+	cellOf[id] = cell;
+}
+
+void SpatialGrid::unlink(int id)
+{
+	int cell = cellOf[id];
+	if (previous[id] >= 0) {
+		next[previous[id]] = next[id];
+	}
+	else {
+		cellHead[cell] = next[id];
+	}
+	if (next[id] >= 0) {
+		previous[next[id]] = previous[id];
+	}
+	next[id] = -1;
+	previous[id] = -1;
+	cellOf[id] = -1;
+}
+
+void SpatialGrid::collectNearSegment(int cell, Point2D from, Point2D to, double radius, std::vector<int>& result) const
+{
+	double dirX = to.x - from.x;
+	double dirY = to.y - from.y;
+	double lengthSquared = dirX * dirX + dirY * dirY;
+	for (int id = cellHead[cell]; id >= 0; id = next[id]) {
+		//closest point of the segment to the entity
+		double t = 0;
+		if (lengthSquared > 0) {
+			t = ((positions[id].x - from.x) * dirX + (positions[id].y - from.y) * dirY) / lengthSquared;
+			t = std::min(std::max(t, 0.0), 1.0);
+		}
+		double dx = from.x + dirX * t - positions[id].x;
+		double dy = from.y + dirY * t - positions[id].y;
+		if (dx * dx + dy * dy <= radius * radius) {
+			result.push_back(id);
+		}
+	}
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <vector>
+#include "Point2D.h"
+#include "Map.h"
+
+/**
+ * @class SpatialGrid
+ * @brief Índice espacial con una cubeta por celda del mapa.
+ *
+ * Cada entidad se identifica con un número entero (por ejemplo el espacio de un enemigo
+ * o el índice de un ítem) y se enlaza en la lista de la celda `GRID_SIZE x GRID_SIZE`
+ * donde está. Mover una entidad solo cambia de lista si cambió de celda, y las consultas
+ * recorren únicamente las celdas cercanas en lugar de todas las entidades.
+ */
+class SpatialGrid {
+public:
+    /**
+     * @brief Agrega una entidad; si ya estaba, solo actualiza su posición.
+     *
+     * @param id Identificador de la entidad (no negativo).
+     * @param position Posición en el mundo.
+     */
+    void insert(int id, Point2D position);
+
+    /**
+     * @brief Actualiza la posición de una entidad, cambiándola de celda si hace falta.
+     *
+     * @param id Identificador de la entidad.
+     * @param position Nueva posición.
+     */
+    void update(int id, Point2D position);
+
+    /**
+     * @brief Quita una entidad del índice.
+     *
+     * @param id Identificador de la entidad.
+     */
+    void remove(int id);
+
+    /**
+     * @brief Quita todas las entidades.
+     */
+    void clear();
+
+    /**
+     * @brief Busca las entidades a una distancia menor o igual que `radius` de un punto.
+     *
+     * @param center Centro de la búsqueda.
+     * @param radius Radio de la búsqueda.
+     * @param result Vector donde se agregan los identificadores encontrados.
+     */
+    void queryRadius(Point2D center, double radius, std::vector<int>& result) const;
+
+    /**
+     * @brief Busca las entidades a una distancia menor o igual que `radius` de un segmento.
+     *
+     * Recorre con DDA las celdas que cruza el segmento, más las vecinas que alcanza el radio.
+     * Las celdas se juntan en un búfer propio del índice, así que no debe llamarse desde
+     * varios hilos a la vez.
+     *
+     * @param from Inicio del segmento.
+     * @param to Fin del segmento.
+     * @param radius Distancia máxima al segmento.
+     * @param result Vector donde se agregan los identificadores encontrados.
+     */
+    void querySegment(Point2D from, Point2D to, double radius, std::vector<int>& result) const;
+
+    /**
+     * @brief Constructor; reserva una cubeta vacía por celda.
+     */
+    SpatialGrid();
+
+private:
+    std::vector<int> cellHead;          ///< Primera entidad de cada celda, o -1.
+    std::vector<int> next;              ///< Siguiente entidad en la misma celda, por id.
+    std::vector<int> previous;          ///< Entidad anterior en la misma celda, por id.
+    std::vector<int> cellOf;            ///< Celda de cada id, o -1 si no está en el índice.
+    std::vector<Point2D> positions;     ///< Última posición de cada id.
+    mutable std::vector<int> segmentCells; ///< Celdas de la última `querySegment`, reutilizado entre consultas.
+
+    /**
+     * @brief Calcula la celda de una posición, limitada a los bordes del mapa.
+     *
+     * @param position Posición en el mundo.
+     * @return Índice de la celda (`fila * GRID_SIZE + columna`).
+     */
+    static int cellIndex(Point2D position);
+
+    /**
+     * @brief Enlaza una entidad al principio de la lista de una celda.
+     */
+    void link(int id, int cell);
+
+    /**
+     * @brief Desenlaza una entidad de la lista de su celda.
+     */
+    void unlink(int id);
+
+    /**
+     * @brief Agrega las entidades de una celda que cumplen la prueba de distancia a un segmento.
+     */
+    void collectNearSegment(int cell, Point2D from, Point2D to, double radius, std::vector<int>& result) const;
+};
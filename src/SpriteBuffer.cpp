@@ -0,0 +1,93 @@
+#include <cmath>
+#include "SpriteBuffer.h"
+
+//branch-free atan2 so the projection loop can be vectorized; error (~2e-4 rad) stays well under one column
+static inline float fastAtan2(float y, float x)
+{
+	float absX = std::fabs(x);
+	float absY = std::fabs(y);
+	float ratio = std::fmin(absX, absY) / std::fmax(std::fmax(absX, absY), 1e-20f);
+	float squared = ratio * ratio;
+	float angle = ((-0.0464964749f * squared + 0.15931422f) * squared - 0.327622764f) * squared * ratio + ratio;
+	angle = absY > absX ? 1.57079637f - angle : angle;
+	angle = x < 0 ? 3.14159274f - angle : angle;
+	return y < 0 ? -angle : angle;
+}
+
+void SpriteBuffer::add(Drawable* sprite)
+{
+	Texture texture = sprite->tex;
+	int frames = 1;
+	Animated* animated = dynamic_cast<Animated*>(sprite);
+	if (animated && animated->animationIndex < (int)animated->animations.size()) {
+		texture = animated->animations[animated->animationIndex]->texture;
+		frames = animated->animations[animated->animationIndex]->numFrames;
+	}
+	owner.push_back(sprite);
+	x.push_back((float)sprite->position.x);
+	y.push_back((float)sprite->position.y);
+	scale.push_back((float)sprite->scale);
+	shift.push_back((float)sprite->shift);
+	aspect.push_back(texture.height > 0 ? (float)texture.width / texture.height / frames : 0.f);
+	texWidth.push_back((float)texture.width);
+}
+
+void SpriteBuffer::project(const SpriteView& view)
+{
+	int count = size();
+	distance.resize(count);
+	screenX.resize(count);
+	posX.resize(count);
+	posY.resize(count);
+	projWidth.resize(count);
+	projHeight.resize(count);
+	onScreen.resize(count);
+
+	const float viewX = (float)view.position.x;
+	const float viewY = (float)view.position.y;
+	const float viewCos = (float)cos(view.angle);
+	const float viewSin = (float)sin(view.angle);
+	const float raysPerRadian = (float)(1 / view.deltaAngle);
+	const float halfNumRays = (float)view.halfNumRays;
+	const float columnScale = (float)view.columnScale;
+	const float screenDist = (float)view.screenDist;
+	const float viewWidth = (float)view.viewWidth;
+	const float halfViewHeight = (float)view.halfViewHeight;
+
+	for (int i = 0; i < count; i++) {
+		float dx = x[i] - viewX;
+		float dy = y[i] - viewY;
+		float dist = std::sqrt(dx * dx + dy * dy);
+		//angle from the view direction, in camera space so it never needs wrapping
+		float forward = dx * viewCos + dy * viewSin;
+		float side = dy * viewCos - dx * viewSin;
+		float centerX = (halfNumRays + fastAtan2(side, forward) * raysPerRadian) * columnScale;
+		float proj = screenDist / std::fmax(dist, 1e-6f) * scale[i];
+		float width = proj * aspect[i];
+		float left = centerX - width / 2;
+
+		distance[i] = dist;
+		screenX[i] = centerX;
+		projHeight[i] = proj;
+		projWidth[i] = width;
+		posX[i] = left;
+		posY[i] = halfViewHeight - proj / 2 + proj * shift[i];
+		onScreen[i] = -texWidth[i] < centerX && centerX < viewWidth + texWidth[i] && dist > 0;
+	}
+}
+
+void SpriteBuffer::clear()
+{
+	owner.clear();
+	x.clear();
+	y.clear();
+	scale.clear();
+	shift.clear();
+	aspect.clear();
+	texWidth.clear();
+}
+
+int SpriteBuffer::size()
+{
+	return owner.size();
+}
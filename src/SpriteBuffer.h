@@ -0,0 +1,78 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "Drawable.h"
+#include "Animated.h"
+#include "Point2D.h"
+
+/**
+ * @struct SpriteView
+ * @brief Parámetros de la cámara que necesita la proyección de sprites.
+ */
+struct SpriteView {
+    Point2D position;    ///< Posición del jugador.
+    double angle;        ///< Ángulo del jugador en radianes.
+    double screenDist;   ///< Distancia a la pantalla en píxeles de la vista.
+    double deltaAngle;   ///< Ángulo entre columnas consecutivas.
+    double halfNumRays;  ///< Mitad del número de rayos.
+    double columnScale;  ///< Píxeles de la vista por rayo.
+    int viewWidth;       ///< Ancho de la vista 3D.
+    int halfViewHeight;  ///< Mitad del alto de la vista 3D.
+};
+
+/**
+ * @class SpriteBuffer
+ * @brief Sprites de un cuadro guardados como estructura de arreglos para proyectarlos juntos.
+ *
+ * `Canvas::draw3D` agrega los sprites que pasan el descarte y luego `project` calcula en
+ * un solo recorrido, sin llamadas virtuales ni copias del jugador, la distancia, la
+ * posición en pantalla y el tamaño proyectado de todos. El bucle trabaja sobre arreglos
+ * contiguos de `float` para que el compilador pueda vectorizarlo.
+ */
+class SpriteBuffer {
+public:
+    // entrada
+    std::vector<Drawable*> owner; ///< Sprite al que pertenece cada entrada.
+    std::vector<float> x;         ///< Posición X en el mundo.
+    std::vector<float> y;         ///< Posición Y en el mundo.
+    std::vector<float> scale;     ///< Escala del sprite.
+    std::vector<float> shift;     ///< Desplazamiento vertical relativo al alto proyectado.
+    std::vector<float> aspect;    ///< Relación ancho/alto de un cuadro de la textura.
+    std::vector<float> texWidth;  ///< Ancho de la textura, usado como margen para descartar.
+
+    // salida de project
+    std::vector<float> distance;   ///< Distancia al jugador.
+    std::vector<float> screenX;    ///< Centro horizontal en la vista.
+    std::vector<float> posX;       ///< Borde izquierdo proyectado.
+    std::vector<float> posY;       ///< Borde superior proyectado.
+    std::vector<float> projWidth;  ///< Ancho proyectado.
+    std::vector<float> projHeight; ///< Alto proyectado.
+    std::vector<uint8_t> onScreen; ///< 1 si el sprite cae dentro de la vista.
+
+    /**
+     * @brief Agrega un sprite al cuadro actual.
+     *
+     * Para los sprites animados se usa la textura y el número de cuadros de la animación activa.
+     *
+     * @param sprite Sprite a proyectar.
+     */
+    void add(Drawable* sprite);
+
+    /**
+     * @brief Proyecta todos los sprites agregados.
+     *
+     * @param view Parámetros de la cámara del cuadro.
+     */
+    void project(const SpriteView& view);
+
+    /**
+     * @brief Vacía el buffer conservando la memoria reservada.
+     */
+    void clear();
+
+    /**
+     * @brief Número de sprites agregados.
+     * @return Cantidad de entradas.
+     */
+    int size();
+};
@@ -13,7 +13,7 @@ void TextureManager::loadTexturesToVRAM()
 			normalizePathSeparator(wallTextures.paths[i]);
 		}
 		for (int i = 0; i < wallTextures.count; i++) {
-			Texture texture = LoadTexture(wallTextures.paths[i]);
+			Texture texture = loadTextureWithMips(wallTextures.paths[i]);
 			std::cout << wallTextures.paths[i] << "\n";
 			(*textures)[wallTextures.paths[i]] = texture;
 		}
@@ -25,7 +25,7 @@ void TextureManager::loadTexturesToVRAM()
 			normalizePathSeparator(staticSpriteTextures.paths[i]);
 		}
 		for (int i = 0; i < staticSpriteTextures.count; i++) {
-			Texture texture = LoadTexture(staticSpriteTextures.paths[i]);
+			Texture texture = loadTextureWithMips(staticSpriteTextures.paths[i]);
 			(*textures)[staticSpriteTextures.paths[i]] = texture;
 		}
 
@@ -36,7 +36,7 @@ void TextureManager::loadTexturesToVRAM()
 			normalizePathSeparator(animatedSpriteTextures.paths[i]);
 		}
 		for (int i = 0; i < animatedSpriteTextures.count; i++) {
-			Texture texture = LoadTexture(animatedSpriteTextures.paths[i]);
+			Texture texture = loadTextureWithMips(animatedSpriteTextures.paths[i]);
 			(*textures)[animatedSpriteTextures.paths[i]] = texture;
 		}
 
@@ -79,6 +79,59 @@ Texture TextureManager::getTexture(std::string fileName)
 	return (*textures)[dir];
 }
 
+std::vector<Texture> TextureManager::getMipChain(Texture texture)
+{
+	auto chain = mipChains->find(texture.id);
+	if (chain == mipChains->end()) {
+		return { texture };
+	}
+	return chain->second;
+}
+
+Texture TextureManager::getMipLevel(Texture texture, double texelsPerPixel)
+{
+	auto chain = mipChains->find(texture.id);
+	if (chain == mipChains->end()) {
+		return texture;
+	}
+	return chain->second[getMipLevelIndex(texelsPerPixel, chain->second.size())];
+}
+
+int TextureManager::getMipLevelIndex(double texelsPerPixel, int levelCount)
+{
+	//each level halves the texels covered by one pixel
+	int level = 0;
+	while (texelsPerPixel >= 2 && level < levelCount - 1) {
+		texelsPerPixel *= 0.5;
+		level++;
+	}
+	return level;
+}
+
+Texture TextureManager::loadTextureWithMips(const char* path)
+{
+	Image image = LoadImage(path);
+	Texture texture = LoadTextureFromImage(image);
+	std::vector<Texture> chain = { texture };
+	//downsample until the smallest side reaches MIN_MIP_SIZE
+	while (image.width / 2 >= MIN_MIP_SIZE && image.height / 2 >= MIN_MIP_SIZE) {
+		ImageResize(&image, image.width / 2, image.height / 2);
+		chain.push_back(LoadTextureFromImage(image));
+	}
+	UnloadImage(image);
+	(*mipChains)[texture.id] = chain;
+	return texture;
+}
+
+std::vector<Texture> TextureManager::getLoadedTextures()
+{
+	std::vector<Texture> loaded;
+	for (auto& entry : *textures) {
+		loaded.push_back(entry.second);
+	}
+	return loaded;
+}
+
 std::string TextureManager::getTextureDir()
 {
 	auto textureDir = std::string("assets/textures/");
@@ -88,6 +141,7 @@ std::string TextureManager::getTextureDir()
 TextureManager::TextureManager()
 {
 	textures = new std::map<std::string,Texture>();
+	mipChains = new std::map<unsigned int, std::vector<Texture>>();
 }
 
 void TextureManager::normalizePathSeparator(char* path)
@@ -2,6 +2,8 @@
 #include <raylib.h>
 #include <map>
 #include <string>
+#include <vector>
+#define MIN_MIP_SIZE 8
 
 /**
  * @class TextureManager
@@ -22,6 +24,43 @@ public:
      */
     Texture getTexture(std::string fileName);
 
+    /**
+     * @brief Obtiene la cadena de mipmaps de una textura.
+     *
+     * El nivel 0 es la propia textura y cada nivel siguiente mide la mitad por lado.
+     * Las texturas sin mipmaps (por ejemplo los fondos) devuelven una cadena de un solo nivel.
+     * @param texture Textura original (nivel 0).
+     * @return Niveles de la cadena, del más grande al más pequeño.
+     */
+    std::vector<Texture> getMipChain(Texture texture);
+
+    /**
+     * @brief Elige el nivel de mipmap adecuado para dibujar una textura reducida.
+     *
+     * @param texture Textura original (nivel 0).
+     * @param texelsPerPixel Texeles del nivel 0 que cubre cada píxel en pantalla.
+     * @return La textura del nivel elegido; el área de origen debe escalarse a su tamaño.
+     */
+    Texture getMipLevel(Texture texture, double texelsPerPixel);
+
+    /**
+     * @brief Calcula el índice de mipmap para una reducción dada.
+     *
+     * @param texelsPerPixel Texeles del nivel 0 que cubre cada píxel en pantalla.
+     * @param levelCount Número de niveles disponibles.
+     * @return Índice del nivel, entre 0 y `levelCount - 1`.
+     */
+    static int getMipLevelIndex(double texelsPerPixel, int levelCount);
+
+    /**
+     * @brief Obtiene todas las texturas cargadas en VRAM.
+     *
+     * Útil para los sistemas que necesitan preparar una copia propia de cada textura,
+     * como el renderizador por software.
+     * @return Lista con todas las texturas cargadas.
+     */
+    std::vector<Texture> getLoadedTextures();
+
     /**
      * @brief Carga todas las texturas en VRAM desde los directorios predefinidos.
      *
@@ -59,6 +98,17 @@ private:
      */
     std::string getTextureDir();
 
+    /**
+     * @brief Carga una textura y genera su cadena de mipmaps.
+     *
+     * Cada nivel se reduce a la mitad del anterior hasta que el lado menor llega a `MIN_MIP_SIZE`
+     * y se sube como una textura independiente, para que el renderizador elija el nivel explícitamente.
+     * @param path Ruta del archivo de imagen.
+     * @return La textura del nivel 0.
+     */
+    Texture loadTextureWithMips(const char* path);
+
     static TextureManager* instance; ///< Instancia única de la clase (Singleton).
     std::map<std::string, Texture>* textures; ///< Mapa para almacenar texturas cargadas por ruta.
+    std::map<unsigned int, std::vector<Texture>>* mipChains; ///< Cadenas de mipmaps indexadas por el id del nivel 0.
 };
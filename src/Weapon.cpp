@@ -1,7 +1,8 @@
 #include "Weapon.h"
 #include "TextureManager.h"
 #include "Player.h"
-#include "SoundManager.h"
+#include "AudioSystem.h"
+#include "AnimationSystem.h"
 #include <iostream>
 
 Weapon::Weapon()
@@ -19,10 +20,7 @@ Weapon::Weapon()
 void Weapon::shoot()
 {
 	if (ammoCount) {
-		SoundManager* soundManager = SoundManager::getInstance();
-		Sound shootSound = soundManager->getSound("shoot.mp3"); //sonido de disparo
-		SetSoundVolume(shootSound, 0.5);
-		PlaySound(shootSound);
+		AudioSystem::getInstance()->play(shootSound, SOUND_PRIORITY_HIGH); //sonido de disparo
 		ammoCount--;
 		reloading = true;
 	}
@@ -36,9 +34,7 @@ bool Weapon::canShoot()
 bool Weapon::refillAmmo(int refill)
 {
 	if (ammoCount < maxAmmo) {
-		SoundManager* soundManager = SoundManager::getInstance();
-		Sound AmmoSound = soundManager->getSound("ammo.mp3"); //sonido de recogida de municion
-		PlaySound(AmmoSound);
+		AudioSystem::getInstance()->play(ammoSound); //sonido de recogida de municion
 		if (ammoCount + refill > maxAmmo) {
 			ammoCount = maxAmmo;
 		}
@@ -59,3 +55,36 @@ int Weapon::getRange()
 {
 	return range;
 }
+
+void Weapon::update()
+{
+	AnimationSystem* animations = AnimationSystem::getInstance();
+	animations->play(*sprite, 0, false);
+	if (reloading) {
+		animations->setPaused(*sprite, false);
+		if (animations->isDone(*sprite)) {
+			reloading = false;
+		}
+	}
+	if (!reloading) {
+		animations->restart(*sprite);
+		animations->setPaused(*sprite, true);
+	}
+}
+
+void Weapon::save(StateWriter& out)
+{
+	out.write<uint32_t>(ammoCount);
+	out.write(reloading);
+	AnimationSystem::getInstance()->save(*sprite, out);
+}
+
+bool Weapon::load(StateReader& in)
+{
+	uint32_t ammo;
+	if (!in.read(ammo) || !in.read(reloading)) {
+		return false;
+	}
+	ammoCount = ammo;
+	return AnimationSystem::getInstance()->load(*sprite, in);
+}
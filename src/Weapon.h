@@ -1,5 +1,6 @@
 #pragma once
 #include "Animated.h"
+#include "SaveState.h"
 
 /**
  * @class Weapon
@@ -59,6 +60,28 @@ public:
      */
     int getRange();
 
+    /**
+     * @brief Reproduce la animación de disparo durante la recarga y la termina cuando acaba.
+     *
+     * Fuera de la recarga la animación queda pausada en el primer cuadro.
+     */
+    void update();
+
+    /**
+     * @brief Guarda la munición, la recarga y la animación del arma.
+     *
+     * @param out Destino.
+     */
+    void save(StateWriter& out);
+
+    /**
+     * @brief Restaura lo que guardó `save`.
+     *
+     * @param in Origen.
+     * @return false si faltaban datos.
+     */
+    bool load(StateReader& in);
+
     /**
      * @brief Sprite animado del arma.
      *
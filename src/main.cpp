@@ -1,8 +1,34 @@
 #include <iostream>
+#include <cstring>
+#include <cstdlib>
 #include "Game.h"
 
-int main() {
+int main(int argc, char* argv[]) {
 	Game game;
+	bool uncapped = false;
+	const char* replayFile = nullptr;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--uncapped") == 0) {
+			uncapped = true;
+		}
+		if (i + 1 >= argc) {
+			continue;
+		}
+		//--stress N replaces every level's enemies with a fixed horde of N, for profiling
+		if (strcmp(argv[i], "--stress") == 0) {
+			game.setStressCount(atoi(argv[i + 1]));
+		}
+		if (strcmp(argv[i], "--record") == 0) {
+			game.setRecording(argv[i + 1]);
+		}
+		if (strcmp(argv[i], "--replay") == 0) {
+			replayFile = argv[i + 1];
+		}
+	}
+	//a replay brings its own settings, so it's applied after the rest of the options
+	if (replayFile && !game.setReplay(replayFile, uncapped)) {
+		return 1;
+	}
 	game.startGame();
 	return 0;
 }
\ No newline at end of file